@@ -13,6 +13,15 @@ namespace EDX {
         public:
             virtual void Build(EDX::RenderData& renderData) = 0;
             virtual bool Traverse(const EDX::Ray& ray, std::vector<RayHit>& results) const = 0;
+
+            /**
+             * @brief Tests whether a ray hits anything in front of it, closer than a maximum distance. 
+             * @remark Returns at the first such hit, rather than gathering every hit to find the nearest. 
+            */
+            virtual bool Occluded(const EDX::Ray& ray, const float maxDistance) const = 0;
+
+            virtual Maths::Vector3f GetBoundsMin() const = 0;
+            virtual Maths::Vector3f GetBoundsMax() const = 0;
         };
     }
 }
@@ -67,40 +67,64 @@ void EDX::Acceleration::Grid::Build(EDX::RenderData& renderData) {
             m_CellSize.y /= (float)gridDimensions.y;
             m_CellSize.z /= (float)gridDimensions.z;
 
-            //m_Cells.resize(gridDimensions.x * gridDimensions.y * gridDimensions.z);
+            auto cellBounds = [&](const int x, const int y, const int z) {
+                EDX::Maths::Vector3f dim = { (float)x, (float)y, (float)z };
+                EDX::Maths::Vector3f cellMin = m_BoundsMin + (m_CellSize * dim);
+                EDX::Maths::Vector3f cellMax = cellMin + m_CellSize;
+                return EDX::Box(cellMin, cellMax);
+            };
+
+            //Returns a conservative range of cell indices along one axis. It's padded by a cell either side to absorb rounding; the exact overlap test has the final say. 
+            auto cellRange = [&](const float min, const float max, const int axis, int& first, int& last) {
+                const int count = gridDimensions[axis];
+                const float size = m_CellSize[axis];
+                first = 0;
+                last = count - 1;
+                if (size > 0.0f && std::isfinite(min) && std::isfinite(max)) {
+                    const float lo = std::floor((min - m_BoundsMin[axis]) / size) - 1.0f;
+                    const float hi = std::floor((max - m_BoundsMin[axis]) / size) + 1.0f;
+                    first = (int)Maths::Clamp(lo, 0.0f, (float)(count - 1));
+                    last = (int)Maths::Clamp(hi, 0.0f, (float)(count - 1));
+                }
+            };
+
+            //Bin each primitive into the cells its cached bounds overlap, rather than testing every primitive against every cell. 
+            //Triangles are binned before spheres, so each cell lists its primitives in the same order as before. 
+            std::vector<std::vector<EDX::Primitive*>> cellPrimitives(gridDimensions.x * gridDimensions.y * gridDimensions.z);
+            auto cellIndex = [&](const int x, const int y, const int z) { return (((z * gridDimensions.y) + y) * gridDimensions.x) + x; };
+            auto binPrimitive = [&](EDX::Primitive& primitive) {
+                const EDX::Box bounds = { primitive.GetBoundsMin(), primitive.GetBoundsMax() };
+
+                EDX::Maths::Vector3i first, last;
+                cellRange(bounds.GetBoundsMin().x, bounds.GetBoundsMax().x, 0, first.x, last.x);
+                cellRange(bounds.GetBoundsMin().y, bounds.GetBoundsMax().y, 1, first.y, last.y);
+                cellRange(bounds.GetBoundsMin().z, bounds.GetBoundsMax().z, 2, first.z, last.z);
+
+                for (int z = first.z; z <= last.z; z++) {
+                    for (int y = first.y; y <= last.y; y++) {
+                        for (int x = first.x; x <= last.x; x++) {
+                            if (cellBounds(x, y, z).Intersects(bounds)) {
+                                cellPrimitives[cellIndex(x, y, z)].push_back(&primitive);
+                            }
+                        }
+                    }
+                }
+            };
+
+            for (auto& tri : renderData.scene.Triangles()) {
+                binPrimitive(tri);
+            }
+            for (auto& sphere : renderData.scene.Spheres()) {
+                binPrimitive(sphere);
+            }
 
-            //TODO: Multithreaded Acceleration Structure Generation
             for (int z = 0; z < gridDimensions.z; z++) {
                 for (int y = 0; y < gridDimensions.y; y++) {
                     for (int x = 0; x < gridDimensions.x; x++) {
-                        EDX::Maths::Vector3f dim = { (float)x, (float)y, (float)z };
-                        EDX::Maths::Vector3f cellMin = m_BoundsMin + (m_CellSize * dim);
-                        EDX::Maths::Vector3f cellMax = cellMin + m_CellSize;
-
-                        uint32_t idx = ConvertXYZToIndex(x, y, z);
-                        //auto xyz = ConvertIndexToXYZ(cellXYZ); 
-                        //m_Cells[idx] = { {cellMin, cellMax}, {} };
-
-                        Cell cell = { { cellMin, cellMax }, {} };
-
-                        //Iterate over each primitive in the scene per-cell, and maintain a list of intersections with each grid cell. 
-                        {
-                            for (auto& tri : renderData.scene.Triangles()) {
-                                if (cell.bounds.Intersects({ tri.GetBoundsMin(), tri.GetBoundsMax() })) {
-                                    cell.intersections.push_back(&tri);
-                                }
-                            }
-                            for (auto& sphere : renderData.scene.Spheres()) {
-                                if (cell.bounds.Intersects({ sphere.GetBoundsMin(), sphere.GetBoundsMax() })) {
-                                    cell.intersections.push_back(&sphere);
-                                }
-                            }
-                        }
-
-                        if (cell.intersections.size() > 0) {
-                            m_Cells.push_back(cell);    //TODO: Replace push_back with an array indexed write. 
+                        std::vector<EDX::Primitive*>& intersections = cellPrimitives[cellIndex(x, y, z)];
+                        if (intersections.size() > 0) {
+                            m_Cells.push_back({ cellBounds(x, y, z), std::move(intersections) });
                         }
-
                     }
                 }
             }
@@ -176,6 +200,7 @@ bool EDX::Acceleration::Grid::Traverse(const EDX::Ray& ray, std::vector<RayHit>&
                 if (pPrimitive->Intersects(ray, l_Result)) {
                     if (l_Result.t > 0.0f) {
                         l_Result.pMat = pPrimitive->GetMaterial();
+                        l_Result.areaLight = pPrimitive->GetAreaLight();
                         results.push_back(l_Result);
                     }
                 }
@@ -299,10 +324,37 @@ for (const auto& cell : m_Cells) {
     return results.empty();
 }
 
+bool EDX::Acceleration::Grid::Occluded(const EDX::Ray& ray, const float maxDistance) const
+{
+    for (auto& cell : m_Cells) {
+        RayHit cellHit = {};
+        if (cell.bounds.Intersects(ray, cellHit)) {
+            for (uint64_t i = 0; i < cell.intersections.size(); i++) {
+                RayHit l_Result = {};
+                if (cell.intersections[i]->Intersects(ray, l_Result) && l_Result.t > 0.0f && l_Result.t < maxDistance) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
 const std::vector<EDX::Acceleration::Grid::Cell>& EDX::Acceleration::Grid::GetCells() const {
     return m_Cells;
 }
 
+EDX::Maths::Vector3f EDX::Acceleration::Grid::GetBoundsMin() const
+{
+    return m_BoundsMin;
+}
+
+EDX::Maths::Vector3f EDX::Acceleration::Grid::GetBoundsMax() const
+{
+    return m_BoundsMax;
+}
+
 int EDX::Acceleration::Grid::ConvertXYZToIndex(int x, int y, int z) const
 {
     return (((z * m_Dimensions.z) + y) * m_Dimensions.x) + x;
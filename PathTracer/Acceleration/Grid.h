@@ -25,9 +25,13 @@ namespace EDX {
             void Build(EDX::RenderData& renderData) override;
 
             bool Traverse(const EDX::Ray& ray, std::vector<RayHit>& results) const override;
+            bool Occluded(const EDX::Ray& ray, const float maxDistance) const override;
 
             const std::vector<EDX::Acceleration::Grid::Cell>& GetCells() const;
 
+            Maths::Vector3f GetBoundsMin() const override;
+            Maths::Vector3f GetBoundsMax() const override;
+
         private:
             int ConvertXYZToIndex(int x, int y, int z) const; 
             Maths::Vector3i ConvertIndexToXYZ(int idx) const; 
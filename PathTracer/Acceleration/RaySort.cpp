@@ -0,0 +1,76 @@
+#include "RaySort.h"
+#include "../Maths/Utils.h"
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Spreads the lower 10 bits of a value so that there are 2 zero bits between each bit.
+    */
+    inline uint64_t SpreadBits(uint32_t v) {
+        uint64_t x = v & 0x3ff;
+        x = (x | (x << 16)) & 0x30000ff;
+        x = (x | (x << 8)) & 0x300f00f;
+        x = (x | (x << 4)) & 0x30c30c3;
+        x = (x | (x << 2)) & 0x9249249;
+        return x;
+    }
+
+    /**
+     * @brief Interleaves three 10-bit values into a 30-bit morton code.
+    */
+    inline uint64_t Morton3D(uint32_t x, uint32_t y, uint32_t z) {
+        return (SpreadBits(x) << 2) | (SpreadBits(y) << 1) | SpreadBits(z);
+    }
+
+    /**
+     * @brief Quantises a value in the range [min, max] to 10 bits.
+    */
+    inline uint32_t Quantise(const float value, const float min, const float max) {
+        const float extent = max - min;
+        if (!(extent > 0.0f)) {
+            return 0;
+        }
+
+        const float t = EDX::Maths::Clamp((value - min) / extent, 0.0f, 1.0f);
+        return static_cast<uint32_t>(t * 1023.0f);
+    }
+}
+
+uint64_t EDX::Acceleration::ComputeRayKey(const Ray& ray, const Maths::Vector3f& boundsMin, const Maths::Vector3f& boundsMax)
+{
+    const Maths::Vector3f o = ray.Origin();
+    const Maths::Vector3f d = ray.Direction();
+
+    const uint64_t octant = (d.x < 0.0f ? 4 : 0) | (d.y < 0.0f ? 2 : 0) | (d.z < 0.0f ? 1 : 0);
+
+    const uint64_t origin = Morton3D(
+        Quantise(o.x, boundsMin.x, boundsMax.x),
+        Quantise(o.y, boundsMin.y, boundsMax.y),
+        Quantise(o.z, boundsMin.z, boundsMax.z)
+    );
+
+    //Directions are (roughly) unit length, so quantise each component over [-1, 1].
+    const uint64_t direction = Morton3D(
+        Quantise(d.x, -1.0f, 1.0f),
+        Quantise(d.y, -1.0f, 1.0f),
+        Quantise(d.z, -1.0f, 1.0f)
+    );
+
+    return (octant << 60) | (origin << 30) | direction;
+}
+
+void EDX::Acceleration::SortRays(const Ray* pRays, const uint64_t count, const Maths::Vector3f& boundsMin, const Maths::Vector3f& boundsMax, std::vector<uint32_t>& order)
+{
+    //Pair each ray's key with its index, so only 16 bytes per ray are moved during the sort.
+    std::vector<std::pair<uint64_t, uint32_t>> keys(count);
+    for (uint64_t i = 0; i < count; i++) {
+        keys[i] = { ComputeRayKey(pRays[i], boundsMin, boundsMax), static_cast<uint32_t>(i) };
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    order.resize(count);
+    for (uint64_t i = 0; i < count; i++) {
+        order[i] = keys[i].second;
+    }
+}
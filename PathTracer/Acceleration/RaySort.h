@@ -0,0 +1,38 @@
+#ifndef __RAYSORT_H
+#define __RAYSORT_H
+/**
+ * @file RaySort.h
+ * @brief Ray Reordering by Direction and Origin
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-02
+*/
+#include "../Ray.h"
+#include <cstdint>
+#include <vector>
+
+namespace EDX {
+    namespace Acceleration {
+
+        /**
+         * @brief Computes a sort key for a ray.
+         * @param ray The ray to compute a key for.
+         * @param boundsMin Minimum bounds of the scene, used to quantise the ray's origin.
+         * @param boundsMax Maximum bounds of the scene, used to quantise the ray's origin.
+         * @return A 64-bit key of the form [octant : 3][origin morton : 30][direction morton : 30].
+         * @remark Rays with equal octants and nearby origins produce nearby keys, so sorting by key groups rays which are likely to visit the same cells and primitives.
+        */
+        uint64_t ComputeRayKey(const Ray& ray, const Maths::Vector3f& boundsMin, const Maths::Vector3f& boundsMax);
+
+        /**
+         * @brief Computes the order in which a set of rays should be traced, binning them by direction octant and quantised origin.
+         * @param pRays Array of rays to sort. The rays themselves are not moved.
+         * @param count Number of rays in pRays.
+         * @param boundsMin Minimum bounds of the scene.
+         * @param boundsMax Maximum bounds of the scene.
+         * @param order Receives the indices of each ray, in sorted order.
+        */
+        void SortRays(const Ray* pRays, const uint64_t count, const Maths::Vector3f& boundsMin, const Maths::Vector3f& boundsMax, std::vector<uint32_t>& order);
+    }
+}
+
+#endif
@@ -71,11 +71,13 @@ float EDX::Camera::GetFoVRadians() const
 void EDX::Camera::SetFoVRadians(const float FoVRadians)
 {
     m_FoVRadians = FoVRadians;
+    UpdateRayBasis();
 }
 
 void EDX::Camera::SetFoVDegrees(const float FoVDegrees)
 {
     m_FoVRadians = Maths::DegToRad(FoVDegrees);
+    UpdateRayBasis();
 }
 
 EDX::Maths::Matrix4x4<float> EDX::Camera::GetViewMatrix() const
@@ -96,6 +98,7 @@ void EDX::Camera::Orbit(Maths::Vector3f& focus, float phi, float theta, float ra
     m_Right = Maths::Vector3f::Cross(m_Forwards, m_Up);
 
     Maths::Vector3f::Orthonormalize(m_Forwards, m_Up, m_Right);
+    UpdateRayBasis();
 }
 
 void EDX::Camera::Look(float dx, float dy, float speed)
@@ -114,20 +117,36 @@ void EDX::Camera::Walk(Maths::Vector3f& direction, float speed)
     m_Position += dir * speed;
 }
 
-EDX::Ray EDX::Camera::GenRay(const Maths::Vector4i viewport, const uint32_t x, const uint32_t y) const
+void EDX::Camera::SetViewport(const Maths::Vector4i viewport)
 {
-    static const Maths::Vector2i dim = { std::abs(viewport.g - viewport.r), std::abs(viewport.a - viewport.z) }; 
+    m_Viewport = viewport;
+    UpdateRayBasis();
+}
 
-    static const float aspectRatio = (float)dim.x / (float)dim.y;
+EDX::Maths::Vector4i EDX::Camera::GetViewport() const
+{
+    return m_Viewport;
+}
 
-    static float FoV_X = (2.0f * atan(tan(m_FoVRadians * 0.5f) * aspectRatio));
-    static const float FoV_Y = m_FoVRadians; 
+EDX::Ray EDX::Camera::GenRay(const float x, const float y) const
+{
+    const float alpha = 4.0f * m_TanHalfFoVX * (((x - (float)m_Viewport.x) - (m_ViewportSize.x / 2.0f)) / m_ViewportSize.x / 2.0f);
+    const float beta = 4.0f * -m_TanHalfFoVY * (((y - (float)m_Viewport.z) - (m_ViewportSize.y / 2.0f)) / m_ViewportSize.y / 2.0f);
 
-    const float alpha = 4.0f * tan(FoV_X / 2.0f) * ((x - ((float)dim.x / 2.0f)) / (float)dim.x / 2.0f);
-    const float beta = 4.0f * -tan(FoV_Y / 2.0f) * ((y - ((float)dim.y / 2.0f)) / (float)dim.y / 2.0f);
+    return Ray(m_Position, Maths::Vector3f::Normalize((alpha * m_Right) + (beta * m_Up) + m_Forwards)); 
+}
+
+void EDX::Camera::UpdateRayBasis()
+{
+    const Maths::Vector2i dim = { std::abs(m_Viewport.y - m_Viewport.x), std::abs(m_Viewport.w - m_Viewport.z) }; 
+    if (dim.x == 0 || dim.y == 0) {
+        return; //The viewport hasn't been set yet. 
+    }
 
-    Maths::Vector3f origin = m_Position; 
-    Maths::Vector3f dir = Maths::Vector3f::Normalize((alpha * m_Right) + (beta * m_Up) + m_Forwards);
+    const float aspectRatio = (float)dim.x / (float)dim.y;
+    const float FoV_X = static_cast<float>(2.0f * std::atan(std::tan((double)(m_FoVRadians * 0.5f)) * aspectRatio));
 
-    return Ray(origin, dir); 
+    m_ViewportSize = { (float)dim.x, (float)dim.y };
+    m_TanHalfFoVX = std::tan((double)(FoV_X / 2.0f));
+    m_TanHalfFoVY = std::tan((double)(m_FoVRadians / 2.0f));
 }
@@ -37,8 +37,22 @@ namespace EDX {
         void Look(float dx, float dy, float speed);
         void Walk(Maths::Vector3f& direction, float speed); 
 
-        //Viewport - {left, right, top, bottom}
-        Ray GenRay(const Maths::Vector4i viewport, const uint32_t x, const uint32_t y) const; 
+        /**
+         * @brief Sets the viewport rays are generated for, and precomputes the raster-to-world ray basis.
+         * @param viewport {left, right, top, bottom}
+        */
+        void SetViewport(const Maths::Vector4i viewport);
+        Maths::Vector4i GetViewport() const;
+
+        /**
+         * @brief Generates a ray through a point on the viewport. SetViewport() must have been called first.
+         * @param x Horizontal raster coordinate. Integer coordinates pass through a pixel's top-left corner.
+         * @param y Vertical raster coordinate.
+        */
+        Ray GenRay(const float x, const float y) const;
+    private:
+        void UpdateRayBasis();
+
     private:
         float m_FoVRadians;
 
@@ -47,6 +61,15 @@ namespace EDX {
         Maths::Vector3f m_Forwards; 
         Maths::Vector3f m_Up; 
         Maths::Vector3f m_Right; 
+
+        //Viewport - {left, right, top, bottom}
+        Maths::Vector4i m_Viewport;
+
+        //Ray basis - the viewport's size, and the tangents of half its horizontal and vertical FoVs. 
+        //These are doubles, as GenRay evaluates in the same precision and order as it always has, to keep rays bit-identical. 
+        Maths::Vector2f m_ViewportSize;
+        double m_TanHalfFoVX;
+        double m_TanHalfFoVY;
     };
 }
 
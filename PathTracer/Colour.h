@@ -8,11 +8,13 @@
 */
 #include <cstdint>
 #include <cmath> 
+#include "Maths/SIMD.h"
 namespace EDX {
     /**
      * @brief Represents a RGBA unorm colour (bounded [0..1])
+     * @remark Colours are 16-byte aligned, and their arithmetic is performed with SIMD::Float4 operations.
     */
-    class Colour {
+    class alignas(16) Colour {
     public:
         Colour() : r(0.0), g(0.0), b(0.0), a(1.0) {};
         Colour(float r_, float g_, float b_, float a_) : r(r_), g(g_), b(b_), a(a_) {}
@@ -23,16 +25,16 @@ namespace EDX {
             a = (float)a_ / (float)0xff;
         }
 
-        friend Colour operator +(Colour lhs, const Colour& rhs) { return { lhs.r + rhs.r, lhs.g + rhs.g ,lhs.b + rhs.b, lhs.a + rhs.a }; }
-        friend Colour operator -(Colour lhs, const Colour& rhs) { return { lhs.r - rhs.r, lhs.g - rhs.g ,lhs.b - rhs.b, lhs.a - rhs.a }; }
-        friend Colour operator *(Colour lhs, const Colour& rhs) { return { lhs.r * rhs.r, lhs.g * rhs.g ,lhs.b * rhs.b, lhs.a * rhs.a }; }
-        friend Colour operator /(Colour lhs, const Colour& rhs) { return { lhs.r / rhs.r, lhs.g / rhs.g ,lhs.b / rhs.b, lhs.a / rhs.a }; }
+        friend Colour operator +(const Colour& lhs, const Colour& rhs) { return FromSIMD(Maths::SIMD::Add(lhs.ToSIMD(), rhs.ToSIMD())); }
+        friend Colour operator -(const Colour& lhs, const Colour& rhs) { return FromSIMD(Maths::SIMD::Sub(lhs.ToSIMD(), rhs.ToSIMD())); }
+        friend Colour operator *(const Colour& lhs, const Colour& rhs) { return FromSIMD(Maths::SIMD::Mul(lhs.ToSIMD(), rhs.ToSIMD())); }
+        friend Colour operator /(const Colour& lhs, const Colour& rhs) { return FromSIMD(Maths::SIMD::Div(lhs.ToSIMD(), rhs.ToSIMD())); }
 
 
-        friend Colour operator +(Colour lhs, const float& rhs) { return { lhs.r + rhs, lhs.g + rhs, lhs.b + rhs, lhs.a + rhs }; }
-        friend Colour operator -(Colour lhs, const float& rhs) { return { lhs.r - rhs, lhs.g - rhs, lhs.b - rhs, lhs.a - rhs }; }
-        friend Colour operator *(Colour lhs, const float& rhs) { return { lhs.r * rhs, lhs.g * rhs, lhs.b * rhs, lhs.a * rhs }; }
-        friend Colour operator /(Colour lhs, const float& rhs) { return { lhs.r / rhs, lhs.g / rhs, lhs.b / rhs, lhs.a / rhs }; }
+        friend Colour operator +(const Colour& lhs, const float& rhs) { return FromSIMD(Maths::SIMD::Add(lhs.ToSIMD(), Maths::SIMD::Set1(rhs))); }
+        friend Colour operator -(const Colour& lhs, const float& rhs) { return FromSIMD(Maths::SIMD::Sub(lhs.ToSIMD(), Maths::SIMD::Set1(rhs))); }
+        friend Colour operator *(const Colour& lhs, const float& rhs) { return FromSIMD(Maths::SIMD::Mul(lhs.ToSIMD(), Maths::SIMD::Set1(rhs))); }
+        friend Colour operator /(const Colour& lhs, const float& rhs) { return FromSIMD(Maths::SIMD::Div(lhs.ToSIMD(), Maths::SIMD::Set1(rhs))); }
 
         /**
          * @brief Returns a Gamma Corrected version of this colour
@@ -48,7 +50,14 @@ namespace EDX {
             return out;
         }
 
-        float r, g, b, a;
+        union {
+            struct { float r, g, b, a; };
+            float arr[4];
+        };
+
+    private:
+        inline Maths::SIMD::Float4 ToSIMD() const { return Maths::SIMD::Load(arr); }
+        inline static Colour FromSIMD(const Maths::SIMD::Float4 v) { Colour out; Maths::SIMD::Store(out.arr, v); return out; }
     };
 }
 
@@ -0,0 +1,47 @@
+#ifndef __SPAN_H
+#define __SPAN_H
+
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+/**
+ * @brief Non-owning view over a contiguous array of elements.
+ * @remark Stand-in for C++20's std::span, as the project targets C++17.
+*/
+namespace EDX {
+    template <typename T>
+    class Span {
+    public:
+        Span() : m_pData(nullptr), m_Size(0) {}
+        Span(T* pData, uint64_t size) : m_pData(pData), m_Size(size) {}
+
+        template <typename U, typename = std::enable_if_t<std::is_same<std::remove_const_t<T>, U>::value>>
+        Span(std::vector<U>& vec) : m_pData(vec.data()), m_Size(vec.size()) {}
+
+        template <typename U, typename = std::enable_if_t<std::is_const<T>::value && std::is_same<std::remove_const_t<T>, U>::value>>
+        Span(const std::vector<U>& vec) : m_pData(vec.data()), m_Size(vec.size()) {}
+
+        //Allow Span<T> -> Span<const T>
+        template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+        Span(const Span<U>& other) : m_pData(other.Data()), m_Size(other.Size()) {}
+
+        T& operator [](uint64_t index) const { return m_pData[index]; }
+
+        T* Data() const { return m_pData; }
+        uint64_t Size() const { return m_Size; }
+        bool Empty() const { return m_Size == 0; }
+
+        T* begin() const { return m_pData; }
+        T* end() const { return m_pData + m_Size; }
+
+        /**
+         * @brief Returns a view over [offset, offset + count) of this span.
+        */
+        Span SubSpan(uint64_t offset, uint64_t count) const { return Span(m_pData + offset, count); }
+
+    private:
+        T* m_pData;
+        uint64_t m_Size;
+    };
+}
+#endif
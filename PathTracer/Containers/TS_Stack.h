@@ -19,6 +19,7 @@ namespace EDX {
             m_Stack.push(std::move(element));
 
             m_Lock.unlock();
+            m_Available.notify_one();
         }
 
         bool Try_Pop(T& element) {
@@ -46,6 +47,52 @@ namespace EDX {
             return elem;
         }
 
+        /**
+         * @brief Pops the top element, if there is one.
+         * @return false if the stack was empty.
+        */
+        bool Wait_And_Pop(T& element) {
+            std::lock_guard<std::mutex> lock(m_Lock);
+
+            if (m_Stack.empty()) {
+                return false;
+            }
+
+            element = m_Stack.top();
+            m_Stack.pop();
+
+            return true;
+        }
+
+        /**
+         * @brief Pops the top element, sleeping until there is one.
+         * @return false if the stack is empty and has been closed.
+        */
+        bool Wait_For_Pop(T& element) {
+            std::unique_lock<std::mutex> lock(m_Lock);
+            m_Available.wait(lock, [this]() { return !m_Stack.empty() || m_IsClosed; });
+
+            if (m_Stack.empty()) {
+                return false;
+            }
+
+            element = m_Stack.top();
+            m_Stack.pop();
+
+            return true;
+        }
+
+        /**
+         * @brief Wakes every thread waiting in Wait_For_Pop once the stack is empty, as nothing more will be pushed.
+        */
+        void Close() {
+            m_Lock.lock();
+            m_IsClosed = true;
+            m_Lock.unlock();
+
+            m_Available.notify_all();
+        }
+
         uint64_t Size() const {
             uint64_t size = 0u;
 
@@ -64,6 +111,8 @@ namespace EDX {
     private:
         std::stack<T> m_Stack;
         mutable std::mutex m_Lock;
+        std::condition_variable m_Available;
+        bool m_IsClosed = false;
     };
 }
 #endif
\ No newline at end of file
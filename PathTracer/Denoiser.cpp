@@ -0,0 +1,192 @@
+#include "Denoiser.h"
+#include "Maths/Utils.h"
+#include "Utils/ParallelFor.h"
+#include <cmath>
+
+constexpr uint32_t g_Iterations = 5;            //Taps reach 2^(iterations + 1) pixels away on the last iteration.
+constexpr uint32_t g_TileSize = 32;             //Each thread filters a tile at a time.
+constexpr float g_ColourSigma = 4.0f;           //Luminance differences are tolerated up to this many standard deviations of the pixel's noise.
+constexpr uint32_t g_NormalSquarings = 7;       //The normal weight is the cosine between normals, squared this many times; i.e. to the power 128.
+constexpr float g_DepthSigma = 1.0f;            //Depth differences are tolerated up to this multiple of the change expected from the surface's slope.
+constexpr float g_AlbedoSigma = 0.1f;           //Albedo differences, summed over channels, are tolerated up to this.
+constexpr float g_WeightEpsilon = 1e-4f;        //Keeps exactly flat features and noiseless pixels from dividing by zero.
+constexpr float g_MinWeight = 1e-6f;            //Taps weighted less than this are skipped; weights near zero are slow denormals, and negligible anyway.
+constexpr float g_MaxExponent = 20.0f;          //exp(-20) is already below g_MinWeight.
+
+//B3 spline taps, by distance from the centre.
+constexpr float g_Kernel[3] = { 3.0f / 8.0f, 1.0f / 4.0f, 1.0f / 16.0f };
+
+namespace {
+    inline float Luminance(const EDX::Colour& c) {
+        return (0.2126f * c.r) + (0.7152f * c.g) + (0.0722f * c.b);
+    }
+}
+
+EDX::FilmFeatures EDX::Denoiser::Features(const Ray& ray, const RayHit& hit)
+{
+    if (hit.t == Maths::Infinity || !hit.pMat) {
+        return { { 0.0f, 0.0f, 0.0f, 1.0f }, -ray.Direction().Normalize(), 0.0f };
+    }
+
+    //Face the normal towards the camera, so both sides of a surface look alike.
+    Maths::Vector3f n = hit.normal;
+    if (Maths::Vector3f::Dot(n, ray.Direction()) > 0.0) {
+        n = -n;
+    }
+
+    Colour albedo = hit.pMat->diffuse + hit.pMat->specular;
+    albedo.r = std::min(albedo.r, 1.0f);
+    albedo.g = std::min(albedo.g, 1.0f);
+    albedo.b = std::min(albedo.b, 1.0f);
+    albedo.a = 1.0f;
+
+    return { albedo, n, static_cast<float>((hit.point - ray.Origin()).Length()) };
+}
+
+void EDX::Denoiser::Denoise(const Film& film, Image& image)
+{
+    const int width = film.Dimensions().x;
+    const int height = film.Dimensions().y;
+    const uint32_t size = film.Size();
+
+    std::vector<Colour> colour(size);
+    std::vector<float> variance(size);
+    std::vector<FilmFeatures> features(size);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const uint32_t i = (y * width) + x;
+            colour[i] = film.GetPixel(x, y);
+            //Pixels with a single sample have no estimate of their noise, so are treated as noiseless; e.g. Whitted renders without antialiasing are left as they are.
+            const float v = film.GetPixelVariance(x, y);
+            variance[i] = std::isinf(v) ? 0.0f : v;
+            features[i] = film.GetFeatures(x, y);
+        }
+    }
+
+    //Estimate how fast depth changes per pixel across each surface. Taking the smaller of the differences either side ignores the jump at an edge.
+    std::vector<Maths::Vector2f> depthGradient(size);
+    auto depthAt = [&](const int x, const int y) {
+        return features[(Maths::Clamp(y, 0, height - 1) * width) + Maths::Clamp(x, 0, width - 1)].depth;
+    };
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const float z = depthAt(x, y);
+            const float dx = std::min(std::fabs(depthAt(x + 1, y) - z), std::fabs(z - depthAt(x - 1, y)));
+            const float dy = std::min(std::fabs(depthAt(x, y + 1) - z), std::fabs(z - depthAt(x, y - 1)));
+            depthGradient[(y * width) + x] = { dx, dy };
+        }
+    }
+
+    std::vector<Colour> nextColour(size);
+    std::vector<float> nextVariance(size);
+    std::vector<float> blurredVariance(size);
+    std::vector<float> luminance(size);
+
+    const uint32_t tilesX = (width + g_TileSize - 1) / g_TileSize;
+    const uint32_t tilesY = (height + g_TileSize - 1) / g_TileSize;
+
+    auto forEachTile = [&](auto&& fn) {
+        ParallelFor((uint64_t)tilesX * tilesY, 1, [&](uint64_t begin, uint64_t end) {
+            for (uint64_t t = begin; t < end; t++) {
+                const int x0 = (int)(t % tilesX) * g_TileSize;
+                const int y0 = (int)(t / tilesX) * g_TileSize;
+                for (int y = y0; y < std::min(y0 + (int)g_TileSize, height); y++) {
+                    for (int x = x0; x < std::min(x0 + (int)g_TileSize, width); x++) {
+                        fn(x, y);
+                    }
+                }
+            }
+        });
+    };
+
+    for (uint32_t iteration = 0; iteration < g_Iterations; iteration++) {
+        const int step = 1 << iteration;
+
+        //A single pixel's variance is itself noisy, so the colour weight uses a 3x3 blur of it.
+        forEachTile([&](const int x, const int y) {
+            luminance[(y * width) + x] = Luminance(colour[(y * width) + x]);
+
+            float sum = 0.0f;
+            float weights = 0.0f;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    const int qx = x + dx;
+                    const int qy = y + dy;
+                    if (qx < 0 || qx >= width || qy < 0 || qy >= height) {
+                        continue;
+                    }
+                    const float w = (dx == 0 ? 2.0f : 1.0f) * (dy == 0 ? 2.0f : 1.0f);
+                    sum += variance[(qy * width) + qx] * w;
+                    weights += w;
+                }
+            }
+            blurredVariance[(y * width) + x] = sum / weights;
+        });
+
+        forEachTile([&](const int x, const int y) {
+            const uint32_t p = (y * width) + x;
+            const FilmFeatures& fp = features[p];
+            const float lp = luminance[p];
+            const float colourScale = 1.0f / ((g_ColourSigma * std::sqrt(blurredVariance[p])) + g_WeightEpsilon);
+
+            Colour sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+            float varianceSum = 0.0f;
+            float weights = 0.0f;
+            for (int dy = -2; dy <= 2; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    const int qx = x + (dx * step);
+                    const int qy = y + (dy * step);
+                    if (qx < 0 || qx >= width || qy < 0 || qy >= height) {
+                        continue;
+                    }
+                    const uint32_t q = (qy * width) + qx;
+                    const FilmFeatures& fq = features[q];
+
+                    //The centre tap always has full weight.
+                    float w = g_Kernel[std::abs(dx)] * g_Kernel[std::abs(dy)];
+                    if (q != p) {
+                        float normalWeight = std::max(static_cast<float>(Maths::Vector3f::Dot(fp.normal, fq.normal)), 0.0f);
+                        for (uint32_t i = 0; i < g_NormalSquarings && normalWeight >= g_MinWeight; i++) {
+                            normalWeight *= normalWeight;
+                        }
+
+                        const float expectedDepth = (std::fabs(depthGradient[p].x * (float)(dx * step)) + std::fabs(depthGradient[p].y * (float)(dy * step))) * g_DepthSigma;
+                        const float depthWeight = std::fabs(fp.depth - fq.depth) / (expectedDepth + g_WeightEpsilon);
+
+                        const Colour albedo = fp.albedo - fq.albedo;
+                        const float albedoWeight = (std::fabs(albedo.r) + std::fabs(albedo.g) + std::fabs(albedo.b)) / g_AlbedoSigma;
+
+                        const float colourWeight = std::fabs(lp - luminance[q]) * colourScale;
+
+                        w *= normalWeight * std::exp(-std::min(depthWeight + albedoWeight + colourWeight, g_MaxExponent));
+                        if (w < g_MinWeight) {
+                            continue;
+                        }
+                    }
+
+                    sum = sum + (colour[q] * w);
+                    varianceSum += variance[q] * w * w;
+                    weights += w;
+                }
+            }
+
+            //Averaging noisy pixels reduces their variance by the square of the weights.
+            nextColour[p] = sum * (1.0f / weights);
+            nextVariance[p] = varianceSum / (weights * weights);
+        });
+
+        std::swap(colour, nextColour);
+        std::swap(variance, nextVariance);
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            Colour clr = colour[(y * width) + x];
+            clr.r = Maths::Clamp(clr.r, 0.0f, 1.0f);
+            clr.g = Maths::Clamp(clr.g, 0.0f, 1.0f);
+            clr.b = Maths::Clamp(clr.b, 0.0f, 1.0f);
+            clr.a = 1.0f;
+            image.SetPixel(x, y, clr);
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef __DENOISER_H
+#define __DENOISER_H
+/**
+ * @file Denoiser.h
+ * @brief Edge-Avoiding A-Trous Wavelet Denoiser
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-15
+*/
+#include "Film.h"
+#include "Ray.h"
+#include "RayHit.h"
+
+namespace EDX {
+
+    class Denoiser {
+    public:
+        /**
+         * @brief Describes what a camera ray hit, for the film's feature buffers.
+        */
+        static FilmFeatures Features(const Ray& ray, const RayHit& hit);
+
+        /**
+         * @brief Filters a film's noisy image into an image, clamped to [0, 1].
+         * @remark Each iteration blurs the image with a 5x5 kernel whose taps are spread twice as far apart as the last (Dammertz et al. 2010).
+         * Taps are weighted down across edges in the film's depth, normals and albedo, and by how far their luminance is from the pixel's, relative to its estimated noise (Schied et al. 2017).
+         * Converged pixels are left almost untouched, and noisy ones blur over flat regions without crossing edges. Each iteration is split across threads by tile.
+        */
+        static void Denoise(const Film& film, Image& image);
+    };
+}
+
+#endif
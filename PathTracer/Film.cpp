@@ -0,0 +1,243 @@
+#include "Film.h"
+#include "Maths/Utils.h"
+
+constexpr uint32_t g_MinErrorSamples = 4;      //Variance estimates from fewer samples are too unreliable to act on. 
+constexpr double g_ErrorLuminanceFloor = 0.1;   //Dark pixels' errors are measured relative to this, so they don't dominate the estimate. 
+constexpr uint32_t g_MinAdaptiveSamples = 16;   //Pixels whose first few samples happen to agree (e.g. all missing a small light) mustn't stop sampling. 
+
+namespace {
+    inline double Luminance(const EDX::Colour& c) {
+        return (0.2126 * c.r) + (0.7152 * c.g) + (0.0722 * c.b);
+    }
+}
+
+EDX::Film::Film(const uint16_t width, const uint16_t height)
+{
+    m_Pixels.resize((uint32_t)width * height, { { 0.0f, 0.0f, 0.0f, 0.0f }, 0.0, 0.0, 0 });
+    m_Features.resize((uint32_t)width * height, { { 0.0f, 0.0f, 0.0f, 0.0f }, {}, 0.0f, 0 });
+    m_Converged.resize((uint32_t)width * height, 0);
+    m_Dimensions = { width, height };
+}
+
+uint32_t EDX::Film::Size() const
+{
+    return m_Dimensions.x * m_Dimensions.y;
+}
+
+EDX::Maths::Vector2<uint16_t> EDX::Film::Dimensions() const
+{
+    return m_Dimensions;
+}
+
+void EDX::Film::AddSample(const uint16_t x, const uint16_t y, const Colour& colour)
+{
+    Pixel& p = m_Pixels[(y * m_Dimensions.x) + x];
+    const double l = Luminance(colour);
+
+    p.sum = p.sum + colour;
+    p.luminanceSum += l;
+    p.luminanceSquaredSum += l * l;
+    p.count++;
+}
+
+void EDX::Film::AddFeatures(const uint16_t x, const uint16_t y, const FilmFeatures& features)
+{
+    FeatureSums& f = m_Features[(y * m_Dimensions.x) + x];
+    f.albedo = f.albedo + features.albedo;
+    f.normal = f.normal + features.normal;
+    f.depth += features.depth;
+    f.count++;
+}
+
+uint32_t EDX::Film::GetSampleCount(const uint16_t x, const uint16_t y) const
+{
+    return m_Pixels[(y * m_Dimensions.x) + x].count;
+}
+
+EDX::Colour EDX::Film::GetPixel(const uint16_t x, const uint16_t y) const
+{
+    const Pixel& p = m_Pixels[(y * m_Dimensions.x) + x];
+    if (p.count == 0) {
+        return { 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+    return p.sum * (1.0f / (float)p.count);
+}
+
+float EDX::Film::GetPixelError(const uint16_t x, const uint16_t y) const
+{
+    const Pixel& p = m_Pixels[(y * m_Dimensions.x) + x];
+    if (p.count < g_MinErrorSamples) {
+        return Maths::Infinity;
+    }
+
+    //Unbiased sample variance, then the standard error of the mean. 
+    const double n = (double)p.count;
+    const double mean = p.luminanceSum / n;
+    const double variance = std::max((p.luminanceSquaredSum - (p.luminanceSum * mean)) / (n - 1.0), 0.0);
+    const double standardError = std::sqrt(variance / n);
+
+    return (float)(standardError / std::max(mean, g_ErrorLuminanceFloor));
+}
+
+float EDX::Film::GetPixelVariance(const uint16_t x, const uint16_t y) const
+{
+    const Pixel& p = m_Pixels[(y * m_Dimensions.x) + x];
+    if (p.count < 2) {
+        return Maths::Infinity;
+    }
+
+    const double n = (double)p.count;
+    const double mean = p.luminanceSum / n;
+    const double variance = std::max((p.luminanceSquaredSum - (p.luminanceSum * mean)) / (n - 1.0), 0.0);
+    return (float)(variance / n);
+}
+
+EDX::FilmFeatures EDX::Film::GetFeatures(const uint16_t x, const uint16_t y) const
+{
+    const FeatureSums& f = m_Features[(y * m_Dimensions.x) + x];
+    if (f.count == 0) {
+        return { { 0.0f, 0.0f, 0.0f, 1.0f }, {}, 0.0f };
+    }
+
+    //Averaging normals across an edge shortens them. 
+    const float scale = 1.0f / (float)f.count;
+    const float length = static_cast<float>(f.normal.Length());
+    return { f.albedo * scale, length > 0.0f ? f.normal / length : f.normal, f.depth * scale };
+}
+
+uint32_t EDX::Film::UpdateConvergence(const float threshold)
+{
+    std::vector<float> errors(Size());
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            errors[(y * m_Dimensions.x) + x] = GetSampleCount(x, y) < g_MinAdaptiveSamples ? Maths::Infinity : GetPixelError(x, y);
+        }
+    }
+
+    //A single pixel's variance estimate is noisy, so pixels only converge with their neighbours. 
+    uint32_t active = 0;
+    for (int y = 0; y < (int)m_Dimensions.y; y++) {
+        for (int x = 0; x < (int)m_Dimensions.x; x++) {
+            float error = 0.0f;
+            for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, (int)m_Dimensions.y - 1); ny++) {
+                for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, (int)m_Dimensions.x - 1); nx++) {
+                    error = std::max(error, errors[(ny * m_Dimensions.x) + nx]);
+                }
+            }
+
+            const bool isConverged = threshold > 0.0f && error <= threshold;
+            m_Converged[(y * m_Dimensions.x) + x] = isConverged ? 1 : 0;
+            active += isConverged ? 0 : 1;
+        }
+    }
+
+    return active;
+}
+
+bool EDX::Film::IsConverged(const uint16_t x, const uint16_t y) const
+{
+    return m_Converged[(y * m_Dimensions.x) + x] != 0;
+}
+
+float EDX::Film::EstimateError() const
+{
+    double error = 0.0;
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            error += GetPixelError(x, y);
+        }
+    }
+    return (float)(error / std::max(Size(), 1u));
+}
+
+void EDX::Film::Resolve(Image& image) const
+{
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            EDX::Colour clr = GetPixel(x, y);
+
+            //Clamp the pixel colour to [0, 1]
+            clr.r = EDX::Maths::Clamp(clr.r, 0.0f, 1.0f);
+            clr.g = EDX::Maths::Clamp(clr.g, 0.0f, 1.0f);
+            clr.b = EDX::Maths::Clamp(clr.b, 0.0f, 1.0f);
+            clr.a = 1.0f;   //Ignore any transparency artifacts. 
+
+            image.SetPixel(x, y, clr);
+        }
+    }
+}
+
+void EDX::Film::ResolveSampleCounts(Image& image) const
+{
+    //Colour ramp, at evenly spaced steps between the fewest and most samples. 
+    const EDX::Colour ramp[] = {
+        { 0.0f, 0.0f, 0.0f, 1.0f },
+        { 0.0f, 0.0f, 1.0f, 1.0f },
+        { 1.0f, 0.0f, 0.0f, 1.0f },
+        { 1.0f, 1.0f, 0.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+    };
+    constexpr uint32_t steps = (sizeof(ramp) / sizeof(ramp[0])) - 1;
+
+    uint32_t minCount = UINT32_MAX;
+    uint32_t maxCount = 0;
+    for (const Pixel& p : m_Pixels) {
+        minCount = std::min(minCount, p.count);
+        maxCount = std::max(maxCount, p.count);
+    }
+    const float range = (float)std::max(maxCount - std::min(minCount, maxCount), 1u);
+
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            const float t = ((float)(GetSampleCount(x, y) - minCount) / range) * steps;
+            const uint32_t i = std::min((uint32_t)t, steps - 1);
+            const float f = t - (float)i;
+
+            EDX::Colour clr = (ramp[i] * (1.0f - f)) + (ramp[i + 1] * f);
+            clr.a = 1.0f;
+            image.SetPixel(x, y, clr);
+        }
+    }
+}
+
+void EDX::Film::ResolveAlbedo(Image& image) const
+{
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            EDX::Colour clr = GetFeatures(x, y).albedo;
+            clr.r = EDX::Maths::Clamp(clr.r, 0.0f, 1.0f);
+            clr.g = EDX::Maths::Clamp(clr.g, 0.0f, 1.0f);
+            clr.b = EDX::Maths::Clamp(clr.b, 0.0f, 1.0f);
+            clr.a = 1.0f;
+            image.SetPixel(x, y, clr);
+        }
+    }
+}
+
+void EDX::Film::ResolveNormals(Image& image) const
+{
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            const Maths::Vector3f n = GetFeatures(x, y).normal;
+            image.SetPixel(x, y, { (n.x * 0.5f) + 0.5f, (n.y * 0.5f) + 0.5f, (n.z * 0.5f) + 0.5f, 1.0f });
+        }
+    }
+}
+
+void EDX::Film::ResolveDepth(Image& image) const
+{
+    float maxDepth = 0.0f;
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            maxDepth = std::max(maxDepth, GetFeatures(x, y).depth);
+        }
+    }
+    const float scale = maxDepth > 0.0f ? 1.0f / maxDepth : 0.0f;
+
+    for (uint16_t y = 0; y < m_Dimensions.y; y++) {
+        for (uint16_t x = 0; x < m_Dimensions.x; x++) {
+            const float d = GetFeatures(x, y).depth * scale;
+            image.SetPixel(x, y, { d, d, d, 1.0f });
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef __FILM_H
+#define __FILM_H
+/**
+ * @file Film.h
+ * @brief Floating-point Accumulation Framebuffer
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-15
+*/
+#include "Colour.h"
+#include "Image.h"
+#include "Maths/Vector2.h"
+#include "Maths/Vector3.h"
+#include <cstdint>
+#include <vector>
+
+namespace EDX {
+    /**
+     * @brief What a sample's camera ray first hit, which guides the denoiser. 
+    */
+    struct FilmFeatures {
+        Colour albedo;
+        Maths::Vector3f normal;     //Facing the camera. Misses use the reverse of the ray's direction. 
+        float depth;                //Distance along the camera ray, or 0 for misses. 
+    };
+
+    /**
+     * @brief Accumulates samples per pixel across progressive passes, and tracks each pixel's luminance variance to estimate its noise.
+     * @remark Pixels are independent, so blocks which don't overlap can add samples concurrently.
+    */
+    class Film {
+    public:
+        Film(const uint16_t width, const uint16_t height);
+
+        uint32_t Size() const;
+        Maths::Vector2<uint16_t> Dimensions() const;
+
+        /**
+         * @brief Adds a sample to a pixel's running sums.
+        */
+        void AddSample(const uint16_t x, const uint16_t y, const Colour& colour);
+
+        /**
+         * @brief Adds a sample's first-hit features to a pixel's running sums, for denoising. 
+        */
+        void AddFeatures(const uint16_t x, const uint16_t y, const FilmFeatures& features);
+
+        uint32_t GetSampleCount(const uint16_t x, const uint16_t y) const;
+
+        /**
+         * @brief Returns the mean of a pixel's samples.
+        */
+        Colour GetPixel(const uint16_t x, const uint16_t y) const;
+
+        /**
+         * @brief Estimates the standard error of a pixel's mean luminance, relative to that luminance.
+         * @return Infinity if the pixel has too few samples to estimate its variance.
+        */
+        float GetPixelError(const uint16_t x, const uint16_t y) const;
+
+        /**
+         * @brief Estimates the variance of a pixel's mean luminance. 
+         * @return Infinity if the pixel has fewer than two samples. 
+        */
+        float GetPixelVariance(const uint16_t x, const uint16_t y) const;
+
+        /**
+         * @brief Returns the mean of a pixel's features. The normal is renormalized. 
+        */
+        FilmFeatures GetFeatures(const uint16_t x, const uint16_t y) const;
+
+        /**
+         * @brief Marks the pixels which need no more samples, for adaptive sampling. 
+         * @param threshold The relative error (see GetPixelError) a pixel and its neighbours must all reach. 
+         * @return The number of pixels which haven't converged.
+         * @remark Pixels must take a minimum number of samples first, so that a few samples which happen to agree don't retire them early. 
+         * Reads neighbouring pixels, so mustn't be called while samples are being added. 
+        */
+        uint32_t UpdateConvergence(const float threshold);
+
+        /**
+         * @brief Checks whether a pixel was marked as converged by the last call to UpdateConvergence.
+        */
+        bool IsConverged(const uint16_t x, const uint16_t y) const;
+
+        /**
+         * @brief Estimates the noise remaining in the image, as the average of every pixel's relative error.
+        */
+        float EstimateError() const;
+
+        /**
+         * @brief Writes the mean of every pixel into an image, clamped to [0, 1].
+        */
+        void Resolve(Image& image) const;
+
+        /**
+         * @brief Writes a heatmap of every pixel's sample count into an image, from black (fewest samples) through blue, red and yellow to white (most).
+        */
+        void ResolveSampleCounts(Image& image) const;
+
+        /**
+         * @brief Write every pixel's mean first-hit albedo, normal (mapped from [-1, 1] to [0, 1]) or depth (scaled by the furthest depth) into an image. 
+        */
+        void ResolveAlbedo(Image& image) const;
+        void ResolveNormals(Image& image) const;
+        void ResolveDepth(Image& image) const;
+
+    private:
+        struct Pixel {
+            Colour sum;
+            double luminanceSum;
+            double luminanceSquaredSum;
+            uint32_t count;
+        };
+
+        struct FeatureSums {
+            Colour albedo;
+            Maths::Vector3f normal;
+            float depth;
+            uint32_t count;
+        };
+
+        std::vector<Pixel> m_Pixels;
+        std::vector<FeatureSums> m_Features;
+        std::vector<uint8_t> m_Converged;
+        Maths::Vector2<uint16_t> m_Dimensions;
+    };
+}
+#endif
@@ -0,0 +1,168 @@
+#include "BinaryScene.h"
+#include "../Utils/Logger.h"
+#include <fstream>
+#include <cstring>
+
+namespace {
+    using EDX::IO::EBinarySceneSection;
+
+    /**
+     * @brief Points a span at a section of the file, after checking that it lies within the file and is aligned.
+    */
+    template <typename T>
+    bool ViewSection(const char* pData, const uint64_t size, const EDX::IO::BinarySceneHeader& header, const EBinarySceneSection section, EDX::Span<const T>& span) {
+        const EDX::IO::BinarySceneSection& s = header.sections[(uint32_t)section];
+        if (s.count == 0) {
+            span = {};
+            return true;
+        }
+
+        if (s.offset % alignof(T) != 0 || s.offset > size || s.count > (size - s.offset) / sizeof(T)) {
+            EDX::Log::Failure("Binary Scene section %u is out of bounds!\n", (uint32_t)section);
+            return false;
+        }
+
+        span = EDX::Span<const T>(reinterpret_cast<const T*>(pData + s.offset), s.count);
+        return true;
+    }
+
+    template <typename T>
+    bool ValidateReferences(const EDX::Span<const T> primitives, const uint64_t numMaterials, const uint64_t numTransforms) {
+        for (const T& p : primitives) {
+            if (p.material >= numMaterials || p.transform >= numTransforms) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline uint64_t Align(const uint64_t offset) {
+        return (offset + EDX::IO::g_BinarySceneAlignment - 1) & ~(EDX::IO::g_BinarySceneAlignment - 1);
+    }
+}
+
+bool EDX::IO::IsBinaryScene(const char* pData, const uint64_t size)
+{
+    return size >= sizeof(g_BinarySceneMagic) && memcmp(pData, g_BinarySceneMagic, sizeof(g_BinarySceneMagic)) == 0;
+}
+
+bool EDX::IO::ReadBinaryScene(const char* pData, const uint64_t size, SceneView& scene)
+{
+    if (!IsBinaryScene(pData, size) || size < sizeof(BinarySceneHeader)) {
+        EDX::Log::Failure("Binary Scene header is invalid!\n");
+        return false;
+    }
+
+    BinarySceneHeader header;
+    memcpy(&header, pData, sizeof(header));
+    if (header.version != g_BinarySceneVersion) {
+        EDX::Log::Failure("Binary Scene version %u is unsupported! (Expected %u)\n", header.version, g_BinarySceneVersion);
+        return false;
+    }
+
+    scene = {};
+    scene.width = header.width;
+    scene.height = header.height;
+    scene.maxDepth = header.maxDepth;
+    scene.hasCamera = (header.flags & BINARY_SCENE_HAS_CAMERA) != 0;
+    scene.camera = header.camera;
+    scene.geometryHash = header.geometryHash;
+    scene.integrator = header.integrator;
+
+    const SceneIntegrator& integrator = scene.integrator;
+    if (integrator.type > SCENE_INTEGRATOR_PATHTRACER || integrator.importanceSampling > SCENE_SAMPLING_BRDF || integrator.sampler > SCENE_SAMPLER_SOBOL || integrator.lightSampling > SCENE_LIGHT_SAMPLING_POWER || !(integrator.timeBudget >= 0.0f) || !(integrator.noiseThreshold >= 0.0f) || !(integrator.adaptiveThreshold >= 0.0f)) {
+        EDX::Log::Failure("Binary Scene integrator settings are invalid!\n");
+        return false;
+    }
+
+    Span<const char> outputName;
+    bool isValid = true;
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::OutputName, outputName);
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::Vertices, scene.vertices);
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::Materials, scene.materials);
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::Transforms, scene.transforms);
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::Triangles, scene.triangles);
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::Spheres, scene.spheres);
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::DirectionalLights, scene.directionalLights);
+    isValid &= ViewSection(pData, size, header, EBinarySceneSection::PointLights, scene.pointLights);
+    if (!isValid) {
+        return false;
+    }
+    scene.outputName = std::string_view(outputName.Data(), outputName.Size());
+
+    //The data is used in place, so check every index once up front, rather than trusting the file.
+    const uint64_t numVertices = scene.vertices.Size();
+    for (const SceneTriangle& t : scene.triangles) {
+        if (t.indices[0] >= numVertices || t.indices[1] >= numVertices || t.indices[2] >= numVertices) {
+            EDX::Log::Failure("Binary Scene references an out of range vertex!\n");
+            return false;
+        }
+    }
+    if (!ValidateReferences(scene.triangles, scene.materials.Size(), scene.transforms.Size()) || !ValidateReferences(scene.spheres, scene.materials.Size(), scene.transforms.Size())) {
+        EDX::Log::Failure("Binary Scene references an out of range material or transform!\n");
+        return false;
+    }
+
+    return true;
+}
+
+bool EDX::IO::WriteBinaryScene(const char* filePath, const SceneView& scene)
+{
+    BinarySceneHeader header = {};
+    memcpy(header.magic, g_BinarySceneMagic, sizeof(header.magic));
+    header.version = g_BinarySceneVersion;
+    header.flags = scene.hasCamera ? static_cast<uint32_t>(BINARY_SCENE_HAS_CAMERA) : static_cast<uint32_t>(0);
+    header.width = scene.width;
+    header.height = scene.height;
+    header.maxDepth = scene.maxDepth;
+    header.camera = scene.camera;
+    header.geometryHash = scene.geometryHash;
+    header.integrator = scene.integrator;
+
+    struct SectionData {
+        const void* pData;
+        uint64_t count;
+        uint64_t stride;
+    };
+
+    const SectionData sections[(uint32_t)EBinarySceneSection::COUNT] = {
+        { scene.outputName.data(), scene.outputName.size(), sizeof(char) },
+        { scene.vertices.Data(), scene.vertices.Size(), sizeof(SceneVertex) },
+        { scene.materials.Data(), scene.materials.Size(), sizeof(SceneMaterial) },
+        { scene.transforms.Data(), scene.transforms.Size(), sizeof(SceneTransform) },
+        { scene.triangles.Data(), scene.triangles.Size(), sizeof(SceneTriangle) },
+        { scene.spheres.Data(), scene.spheres.Size(), sizeof(SceneSphere) },
+        { scene.directionalLights.Data(), scene.directionalLights.Size(), sizeof(SceneDirectionalLight) },
+        { scene.pointLights.Data(), scene.pointLights.Size(), sizeof(ScenePointLight) },
+    };
+
+    //Lay out each section on an aligned boundary after the header.
+    uint64_t offset = Align(sizeof(BinarySceneHeader));
+    for (uint32_t i = 0; i < (uint32_t)EBinarySceneSection::COUNT; i++) {
+        header.sections[i].offset = offset;
+        header.sections[i].count = sections[i].count;
+        offset = Align(offset + sections[i].count * sections[i].stride);
+    }
+
+    std::ofstream outFile(filePath, std::ios::binary | std::ios::trunc);
+    if (!outFile.is_open()) {
+        EDX::Log::Failure("Failed to open \"%s\" for writing!\n", filePath);
+        return false;
+    }
+
+    const char padding[g_BinarySceneAlignment] = {};
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t written = sizeof(header);
+    for (uint32_t i = 0; i < (uint32_t)EBinarySceneSection::COUNT; i++) {
+        outFile.write(padding, header.sections[i].offset - written);
+        outFile.write(static_cast<const char*>(sections[i].pData), sections[i].count * sections[i].stride);
+        written = header.sections[i].offset + sections[i].count * sections[i].stride;
+    }
+
+    if (!outFile.good()) {
+        EDX::Log::Failure("Failed to write Binary Scene \"%s\"!\n", filePath);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef __BINARYSCENE_H
+#define __BINARYSCENE_H
+/**
+ * @file BinaryScene.h
+ * @brief Binary Scene File Format
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-06
+*/
+#include "SceneDescription.h"
+
+namespace EDX {
+    namespace IO {
+        /*
+         * A binary scene is a fixed header, followed by one tightly-packed array per section.
+         * Each section begins on a 64-byte boundary, so a memory-mapped file can be viewed in place, without parsing.
+         * All values are little-endian.
+        */
+
+        enum class EBinarySceneSection : uint32_t {
+            OutputName = 0,     //char[]
+            Vertices,           //SceneVertex[]
+            Materials,          //SceneMaterial[]
+            Transforms,         //SceneTransform[]
+            Triangles,          //SceneTriangle[]
+            Spheres,            //SceneSphere[]
+            DirectionalLights,  //SceneDirectionalLight[]
+            PointLights,        //ScenePointLight[]
+            COUNT
+        };
+
+        enum EBinarySceneFlags : uint32_t {
+            BINARY_SCENE_HAS_CAMERA = 1 << 0,
+        };
+
+        struct BinarySceneSection {
+            uint64_t offset;    //Offset from the start of the file, in bytes.
+            uint64_t count;     //Number of elements in the section.
+        };
+
+        struct BinarySceneHeader {
+            char magic[8];      //"EDXSCENE"
+            uint32_t version;
+            uint32_t flags;     //EBinarySceneFlags
+            uint16_t width;
+            uint16_t height;
+            uint32_t maxDepth;
+            SceneCamera camera;
+            uint64_t geometryHash;
+            SceneIntegrator integrator;
+            BinarySceneSection sections[(uint32_t)EBinarySceneSection::COUNT];
+        };
+
+        static_assert(sizeof(BinarySceneHeader) == 248, "BinarySceneHeader must not contain padding.");
+
+        constexpr char g_BinarySceneMagic[8] = { 'E', 'D', 'X', 'S', 'C', 'E', 'N', 'E' };
+        constexpr uint32_t g_BinarySceneVersion = 7;
+        constexpr uint64_t g_BinarySceneAlignment = 64;
+
+        /**
+         * @brief Returns true if the buffer begins with a binary scene header.
+        */
+        bool IsBinaryScene(const char* pData, const uint64_t size);
+
+        /**
+         * @brief Views a binary scene in place. No data is copied, so the buffer must outlive the view.
+         * @return false if the file is truncated, from an unsupported version, or references out-of-range elements.
+        */
+        bool ReadBinaryScene(const char* pData, const uint64_t size, SceneView& scene);
+
+        /**
+         * @brief Writes a scene to a binary scene file.
+        */
+        bool WriteBinaryScene(const char* filePath, const SceneView& scene);
+    }
+}
+
+#endif
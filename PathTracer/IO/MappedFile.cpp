@@ -0,0 +1,126 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32) || defined(WIN32)
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+EDX::IO::MappedFile::MappedFile()
+{
+    m_pData = nullptr;
+    m_Size = 0;
+
+#if defined(_WIN32) || defined(WIN32)
+    m_hFile = INVALID_HANDLE_VALUE;
+    m_hMapping = nullptr;
+#else
+    m_FileDescriptor = -1;
+#endif
+}
+
+EDX::IO::MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool EDX::IO::MappedFile::Open(const char* filePath)
+{
+    Close();
+
+#if defined(_WIN32) || defined(WIN32)
+    m_hFile = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(m_hFile, &size) || size.QuadPart == 0) {
+        Close();
+        return false;
+    }
+    m_Size = static_cast<uint64_t>(size.QuadPart);
+
+    m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_hMapping) {
+        Close();
+        return false;
+    }
+
+    m_pData = static_cast<const char*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_pData) {
+        Close();
+        return false;
+    }
+#else
+    m_FileDescriptor = open(filePath, O_RDONLY);
+    if (m_FileDescriptor < 0) {
+        return false;
+    }
+
+    struct stat info = {};
+    if (fstat(m_FileDescriptor, &info) != 0 || info.st_size == 0) {
+        Close();
+        return false;
+    }
+    m_Size = static_cast<uint64_t>(info.st_size);
+
+    void* pMapping = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0);
+    if (pMapping == MAP_FAILED) {
+        Close();
+        return false;
+    }
+
+    //The file is read front-to-back, so ask for aggressive read-ahead.
+    madvise(pMapping, m_Size, MADV_SEQUENTIAL);
+    m_pData = static_cast<const char*>(pMapping);
+#endif
+
+    return true;
+}
+
+void EDX::IO::MappedFile::Close()
+{
+#if defined(_WIN32) || defined(WIN32)
+    if (m_pData) {
+        UnmapViewOfFile(m_pData);
+    }
+    if (m_hMapping) {
+        CloseHandle(m_hMapping);
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_hFile);
+    }
+    m_hMapping = nullptr;
+    m_hFile = INVALID_HANDLE_VALUE;
+#else
+    if (m_pData) {
+        munmap(const_cast<char*>(m_pData), m_Size);
+    }
+    if (m_FileDescriptor >= 0) {
+        close(m_FileDescriptor);
+    }
+    m_FileDescriptor = -1;
+#endif
+
+    m_pData = nullptr;
+    m_Size = 0;
+}
+
+bool EDX::IO::MappedFile::IsOpen() const
+{
+    return m_pData != nullptr;
+}
+
+const char* EDX::IO::MappedFile::Data() const
+{
+    return m_pData;
+}
+
+uint64_t EDX::IO::MappedFile::Size() const
+{
+    return m_Size;
+}
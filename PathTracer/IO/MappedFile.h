@@ -0,0 +1,50 @@
+#ifndef __MAPPEDFILE_H
+#define __MAPPEDFILE_H
+/**
+ * @file MappedFile.h
+ * @brief Read-only Memory-Mapped File
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-05
+*/
+#include <cstdint>
+
+namespace EDX {
+    namespace IO {
+        /**
+         * @brief Maps a file into memory for reading. The mapping is released when the object is destroyed.
+        */
+        class MappedFile {
+        public:
+            MappedFile();
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /**
+             * @brief Maps a file into memory.
+             * @return false if the file couldn't be opened or mapped.
+            */
+            bool Open(const char* filePath);
+            void Close();
+
+            bool IsOpen() const;
+
+            const char* Data() const;
+            uint64_t Size() const;
+
+        private:
+            const char* m_pData;
+            uint64_t m_Size;
+
+#if defined(_WIN32) || defined(WIN32)
+            void* m_hFile;
+            void* m_hMapping;
+#else
+            int m_FileDescriptor;
+#endif
+        };
+    }
+}
+
+#endif
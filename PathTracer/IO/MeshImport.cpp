@@ -0,0 +1,466 @@
+#include "MeshImport.h"
+#include "MappedFile.h"
+#include "SceneParser.h"
+#include "../Utils/Logger.h"
+#include "../Utils/Timer.h"
+#include <cstring>
+
+namespace {
+    /**
+     * @brief Appends a polygon to the scene as a fan of triangles around its first vertex.
+    */
+    inline void AppendPolygon(const uint32_t* pIndices, const uint32_t count, const uint32_t material, const uint32_t transform, EDX::IO::SceneDescription& scene) {
+        for (uint32_t i = 2; i < count; i++) {
+            scene.triangles.push_back({ { pIndices[0], pIndices[i - 1], pIndices[i] }, material, transform });
+        }
+    }
+
+    //Wavefront OBJ
+
+    bool ImportOBJ(const char* pData, const uint64_t size, const char* filePath, const uint32_t material, const uint32_t transform, EDX::IO::SceneDescription& scene) {
+        const uint64_t baseVertex = scene.vertices.size();
+        bool isValid = true;
+
+        std::vector<uint32_t> polygon;
+        EDX::IO::ForEachLine(pData, pData + size, [&](const std::string_view line, const uint64_t lineNumber) {
+            if (!isValid) {
+                return;
+            }
+
+            uint64_t offset = 0;
+            const std::string_view type = EDX::IO::NextToken(line, offset);
+
+            //Vertex Position
+            //v [x] [y] [z] ([w])
+            if (type == "v") {
+                EDX::IO::SceneVertex v;
+                v.position[0] = EDX::IO::ParseNumber<float>(EDX::IO::NextToken(line, offset));
+                v.position[1] = EDX::IO::ParseNumber<float>(EDX::IO::NextToken(line, offset));
+                v.position[2] = EDX::IO::ParseNumber<float>(EDX::IO::NextToken(line, offset));
+                scene.vertices.push_back(v);
+            }
+            //Face
+            //f [v/vt/vn] [v/vt/vn] [v/vt/vn] ...
+            else if (type == "f") {
+                const int64_t numVertices = static_cast<int64_t>(scene.vertices.size() - baseVertex);
+
+                polygon.clear();
+                for (std::string_view token = EDX::IO::NextToken(line, offset); !token.empty(); token = EDX::IO::NextToken(line, offset)) {
+                    //Only the position index is used; texture coordinate and normal indices follow a '/'.
+                    const int64_t index = EDX::IO::ParseNumber<int64_t>(token.substr(0, token.find('/')));
+
+                    //Indices are 1-based, and negative indices count back from the most recent vertex.
+                    const int64_t resolved = index < 0 ? numVertices + index : index - 1;
+                    if (index == 0 || resolved < 0 || resolved >= numVertices) {
+                        EDX::Log::Failure("Failed to import Mesh \"%s\": Face on line %llu references an undefined vertex!\n", filePath, (unsigned long long)lineNumber);
+                        isValid = false;
+                        return;
+                    }
+
+                    polygon.push_back(static_cast<uint32_t>(baseVertex + resolved));
+                }
+
+                AppendPolygon(polygon.data(), static_cast<uint32_t>(polygon.size()), material, transform, scene);
+            }
+            //Normals, texture coordinates, groups and materials are ignored.
+        });
+
+        return isValid;
+    }
+
+    //Stanford PLY
+
+    enum class EPLYType : uint8_t {
+        INVALID = 0,
+        INT8,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        FLOAT32,
+        FLOAT64,
+    };
+
+    struct PLYProperty {
+        std::string_view name;
+        EPLYType type;
+        EPLYType countType;     //Type of a list's element count. INVALID for scalar properties.
+    };
+
+    struct PLYElement {
+        std::string_view name;
+        uint64_t count;
+        std::vector<PLYProperty> properties;
+    };
+
+    EPLYType ParsePLYType(const std::string_view name) {
+        if (name == "char" || name == "int8") return EPLYType::INT8;
+        if (name == "uchar" || name == "uint8") return EPLYType::UINT8;
+        if (name == "short" || name == "int16") return EPLYType::INT16;
+        if (name == "ushort" || name == "uint16") return EPLYType::UINT16;
+        if (name == "int" || name == "int32") return EPLYType::INT32;
+        if (name == "uint" || name == "uint32") return EPLYType::UINT32;
+        if (name == "float" || name == "float32") return EPLYType::FLOAT32;
+        if (name == "double" || name == "float64") return EPLYType::FLOAT64;
+        return EPLYType::INVALID;
+    }
+
+    uint32_t PLYTypeSize(const EPLYType type) {
+        switch (type) {
+        case EPLYType::INT8:
+        case EPLYType::UINT8:
+            return 1;
+        case EPLYType::INT16:
+        case EPLYType::UINT16:
+            return 2;
+        case EPLYType::INT32:
+        case EPLYType::UINT32:
+        case EPLYType::FLOAT32:
+            return 4;
+        case EPLYType::FLOAT64:
+            return 8;
+        default:
+            return 0;
+        }
+    }
+
+    enum class EPLYFormat : uint8_t {
+        INVALID = 0,
+        ASCII,
+        BINARY_LITTLE_ENDIAN,
+        BINARY_BIG_ENDIAN,
+    };
+
+    inline bool IsLittleEndianHost() {
+        const uint16_t one = 1;
+        uint8_t firstByte;
+        memcpy(&firstByte, &one, 1);
+        return firstByte == 1;
+    }
+
+    /**
+     * @brief Sequential reader over the body of a PLY file, which converts each value to a double in the host's byte order.
+    */
+    class PLYCursor {
+    public:
+        PLYCursor(const char* pBegin, const char* pEnd, const EPLYFormat format) : m_pCursor(pBegin), m_pEnd(pEnd), m_Format(format) {
+            m_SwapBytes = (format == EPLYFormat::BINARY_BIG_ENDIAN) == IsLittleEndianHost();
+        }
+
+        bool IsBinary() const { return m_Format != EPLYFormat::ASCII; }
+        bool SwapBytes() const { return m_SwapBytes; }
+        const char* Cursor() const { return m_pCursor; }
+        uint64_t Remaining() const { return m_pEnd - m_pCursor; }
+        void Skip(const uint64_t bytes) { m_pCursor += bytes; }
+
+        /**
+         * @brief Reads the next value.
+         * @return false if the body ends before the value.
+        */
+        bool Next(const EPLYType type, double& value) {
+            if (m_Format == EPLYFormat::ASCII) {
+                while (m_pCursor < m_pEnd && (IsWhitespace(*m_pCursor) || *m_pCursor == '\n')) {
+                    m_pCursor++;
+                }
+                const char* pToken = m_pCursor;
+                while (m_pCursor < m_pEnd && !IsWhitespace(*m_pCursor) && *m_pCursor != '\n') {
+                    m_pCursor++;
+                }
+                if (pToken == m_pCursor) {
+                    return false;
+                }
+                value = EDX::IO::ParseNumber<double>(std::string_view(pToken, m_pCursor - pToken));
+                return true;
+            }
+
+            const uint32_t size = PLYTypeSize(type);
+            if (Remaining() < size) {
+                return false;
+            }
+            value = Decode(m_pCursor, type, m_SwapBytes);
+            m_pCursor += size;
+            return true;
+        }
+
+        /**
+         * @brief Decodes a single binary value.
+        */
+        static double Decode(const char* pValue, const EPLYType type, const bool swapBytes) {
+            uint8_t bytes[8];
+            const uint32_t size = PLYTypeSize(type);
+            memcpy(bytes, pValue, size);
+
+            if (swapBytes) {
+                for (uint32_t i = 0; i < size / 2; i++) {
+                    std::swap(bytes[i], bytes[size - 1 - i]);
+                }
+            }
+
+            switch (type) {
+            case EPLYType::INT8: { int8_t v; memcpy(&v, bytes, 1); return v; }
+            case EPLYType::UINT8: { uint8_t v; memcpy(&v, bytes, 1); return v; }
+            case EPLYType::INT16: { int16_t v; memcpy(&v, bytes, 2); return v; }
+            case EPLYType::UINT16: { uint16_t v; memcpy(&v, bytes, 2); return v; }
+            case EPLYType::INT32: { int32_t v; memcpy(&v, bytes, 4); return v; }
+            case EPLYType::UINT32: { uint32_t v; memcpy(&v, bytes, 4); return v; }
+            case EPLYType::FLOAT32: { float v; memcpy(&v, bytes, 4); return v; }
+            case EPLYType::FLOAT64: { double v; memcpy(&v, bytes, 8); return v; }
+            default: return 0.0;
+            }
+        }
+
+    private:
+        static bool IsWhitespace(const char c) { return EDX::IO::IsWhitespace(c); }
+
+        const char* m_pCursor;
+        const char* m_pEnd;
+        EPLYFormat m_Format;
+        bool m_SwapBytes;
+    };
+
+    /**
+     * @brief Reads every record of an element, passing list properties to onList(property, count, cursor). Scalar properties are skipped.
+    */
+    template <typename Fn>
+    bool ReadPLYElement(PLYCursor& cursor, const PLYElement& element, Fn&& onList) {
+        double value = 0.0;
+        for (uint64_t i = 0; i < element.count; i++) {
+            for (const PLYProperty& p : element.properties) {
+                if (p.countType == EPLYType::INVALID) {
+                    if (!cursor.Next(p.type, value)) {
+                        return false;
+                    }
+                    continue;
+                }
+
+                if (!cursor.Next(p.countType, value) || value < 0.0) {
+                    return false;
+                }
+                if (!onList(p, static_cast<uint32_t>(value), cursor)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads a vertex element's x, y and z properties.
+     * @remark Binary records which are exactly three host-order floats are copied in a single memcpy. Other binary layouts are read with a fixed stride, without tokenising.
+    */
+    bool ReadPLYVertices(PLYCursor& cursor, const PLYElement& element, EDX::IO::SceneDescription& scene) {
+        int32_t offsets[3] = { -1, -1, -1 };
+        EPLYType types[3] = {};
+        uint64_t stride = 0;
+        for (const PLYProperty& p : element.properties) {
+            if (p.countType != EPLYType::INVALID) {
+                return false;   //Vertex records must be fixed-size.
+            }
+
+            const int32_t axis = p.name == "x" ? 0 : p.name == "y" ? 1 : p.name == "z" ? 2 : -1;
+            if (axis >= 0) {
+                offsets[axis] = static_cast<int32_t>(stride);
+                types[axis] = p.type;
+            }
+            stride += PLYTypeSize(p.type);
+        }
+        if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0) {
+            return false;
+        }
+
+        const uint64_t base = scene.vertices.size();
+
+        if (!cursor.IsBinary()) {
+            //Every ASCII value takes at least two bytes, including its separator.
+            if (element.count > cursor.Remaining() / (2 * element.properties.size())) {
+                return false;
+            }
+            scene.vertices.resize(base + element.count);
+            double value = 0.0;
+            for (uint64_t i = 0; i < element.count; i++) {
+                for (const PLYProperty& p : element.properties) {
+                    if (!cursor.Next(p.type, value)) {
+                        return false;
+                    }
+                    const int32_t axis = p.name == "x" ? 0 : p.name == "y" ? 1 : p.name == "z" ? 2 : -1;
+                    if (axis >= 0) {
+                        scene.vertices[base + i].position[axis] = static_cast<float>(value);
+                    }
+                }
+            }
+            return true;
+        }
+
+        if (element.count > cursor.Remaining() / stride) {
+            return false;
+        }
+        scene.vertices.resize(base + element.count);
+
+        const bool isPacked = stride == sizeof(EDX::IO::SceneVertex) && offsets[0] == 0 && offsets[1] == 4 && offsets[2] == 8
+            && types[0] == EPLYType::FLOAT32 && types[1] == EPLYType::FLOAT32 && types[2] == EPLYType::FLOAT32;
+
+        if (isPacked && !cursor.SwapBytes()) {
+            memcpy(scene.vertices.data() + base, cursor.Cursor(), element.count * stride);
+        }
+        else {
+            const char* pRecord = cursor.Cursor();
+            for (uint64_t i = 0; i < element.count; i++, pRecord += stride) {
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    scene.vertices[base + i].position[axis] = static_cast<float>(PLYCursor::Decode(pRecord + offsets[axis], types[axis], cursor.SwapBytes()));
+                }
+            }
+        }
+        cursor.Skip(element.count * stride);
+
+        return true;
+    }
+
+    bool ImportPLY(const char* pData, const uint64_t size, const char* filePath, const uint32_t material, const uint32_t transform, EDX::IO::SceneDescription& scene) {
+        //Parse the header, which ends with an "end_header" line.
+        EPLYFormat format = EPLYFormat::INVALID;
+        std::vector<PLYElement> elements;
+        const char* pBody = nullptr;
+        {
+            const char* pCursor = pData;
+            const char* pEnd = pData + size;
+            while (pCursor < pEnd && !pBody) {
+                const char* pEOL = static_cast<const char*>(memchr(pCursor, '\n', pEnd - pCursor));
+                if (!pEOL) {
+                    break;
+                }
+
+                std::string_view line(pCursor, pEOL - pCursor);
+                pCursor = pEOL + 1;
+
+                uint64_t offset = 0;
+                const std::string_view keyword = EDX::IO::NextToken(line, offset);
+                if (keyword == "format") {
+                    const std::string_view name = EDX::IO::NextToken(line, offset);
+                    format = name == "ascii" ? EPLYFormat::ASCII : name == "binary_little_endian" ? EPLYFormat::BINARY_LITTLE_ENDIAN : name == "binary_big_endian" ? EPLYFormat::BINARY_BIG_ENDIAN : EPLYFormat::INVALID;
+                }
+                else if (keyword == "element") {
+                    PLYElement element = {};
+                    element.name = EDX::IO::NextToken(line, offset);
+                    element.count = EDX::IO::ParseNumber<uint64_t>(EDX::IO::NextToken(line, offset));
+                    elements.push_back(element);
+                }
+                else if (keyword == "property" && !elements.empty()) {
+                    PLYProperty property = {};
+                    std::string_view type = EDX::IO::NextToken(line, offset);
+                    if (type == "list") {
+                        property.countType = ParsePLYType(EDX::IO::NextToken(line, offset));
+                        type = EDX::IO::NextToken(line, offset);
+                        if (property.countType == EPLYType::INVALID) {
+                            format = EPLYFormat::INVALID;
+                        }
+                    }
+                    property.type = ParsePLYType(type);
+                    property.name = EDX::IO::NextToken(line, offset);
+                    if (property.type == EPLYType::INVALID) {
+                        format = EPLYFormat::INVALID;
+                    }
+                    elements.back().properties.push_back(property);
+                }
+                else if (keyword == "end_header") {
+                    pBody = pCursor;
+                }
+                //Comments and obj_info lines are ignored.
+            }
+        }
+
+        if (!pBody || format == EPLYFormat::INVALID) {
+            EDX::Log::Failure("Failed to import Mesh \"%s\": PLY header is invalid or uses an unsupported type!\n", filePath);
+            return false;
+        }
+
+        const uint64_t baseVertex = scene.vertices.size();
+
+        PLYCursor cursor(pBody, pData + size, format);
+        std::vector<uint32_t> polygon;
+        double value = 0.0;
+        for (const PLYElement& element : elements) {
+            bool isValid = true;
+            if (element.name == "vertex") {
+                isValid = ReadPLYVertices(cursor, element, scene);
+            }
+            else {
+                const bool isFace = element.name == "face";
+                isValid = ReadPLYElement(cursor, element, [&](const PLYProperty& p, const uint32_t count, PLYCursor& c) {
+                    const bool isIndices = isFace && (p.name == "vertex_indices" || p.name == "vertex_index");
+                    if (!isIndices && c.IsBinary()) {
+                        //Skip lists we don't use without decoding them.
+                        const uint64_t bytes = (uint64_t)count * PLYTypeSize(p.type);
+                        if (bytes > c.Remaining()) {
+                            return false;
+                        }
+                        c.Skip(bytes);
+                        return true;
+                    }
+
+                    polygon.clear();
+                    for (uint32_t i = 0; i < count; i++) {
+                        if (!c.Next(p.type, value) || value < 0.0) {
+                            return false;
+                        }
+                        polygon.push_back(static_cast<uint32_t>(baseVertex + static_cast<uint64_t>(value)));
+                    }
+                    if (isIndices) {
+                        AppendPolygon(polygon.data(), count, material, transform, scene);
+                    }
+                    return true;
+                });
+            }
+
+            if (!isValid) {
+                EDX::Log::Failure("Failed to import Mesh \"%s\": Element \"%.*s\" is truncated or malformed!\n", filePath, (int)element.name.size(), element.name.data());
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+bool EDX::IO::ImportMesh(const char* filePath, const uint32_t material, const uint32_t transform, SceneDescription& scene)
+{
+    EDX::Timer timer;
+    timer.Start();
+
+    MappedFile file;
+    if (!file.Open(filePath)) {
+        EDX::Log::Failure("Failed to import Mesh \"%s\": Unable to open file!\n", filePath);
+        return false;
+    }
+
+    const uint64_t baseVertex = scene.vertices.size();
+    const uint64_t baseTriangle = scene.triangles.size();
+
+    //PLY files always begin with "ply"; anything else is treated as OBJ.
+    const bool isPLY = file.Size() >= 4 && memcmp(file.Data(), "ply", 3) == 0 && (file.Data()[3] == '\n' || file.Data()[3] == '\r');
+    bool isValid = isPLY ? ImportPLY(file.Data(), file.Size(), filePath, material, transform, scene) : ImportOBJ(file.Data(), file.Size(), filePath, material, transform, scene);
+
+    //PLY faces may precede or reference any vertex in the file, so validate indices once everything is read. OBJ rejects forward references as it reads each face.
+    if (isValid) {
+        for (uint64_t i = baseTriangle; i < scene.triangles.size() && isValid; i++) {
+            const SceneTriangle& t = scene.triangles[i];
+            for (uint32_t v = 0; v < 3; v++) {
+                isValid &= t.indices[v] >= baseVertex && t.indices[v] < scene.vertices.size();
+            }
+        }
+        if (!isValid) {
+            EDX::Log::Failure("Failed to import Mesh \"%s\": A face references an undefined vertex!\n", filePath);
+        }
+    }
+
+    if (!isValid) {
+        scene.vertices.resize(baseVertex);
+        scene.triangles.resize(baseTriangle);
+        return false;
+    }
+
+    timer.Tick();
+    const double dt = timer.DeltaTime();
+    EDX::Log::Status("Imported Mesh \"%s\": %llu vertices, %llu triangles in %fs (%.2f MB/s).\n", filePath, (unsigned long long)(scene.vertices.size() - baseVertex), (unsigned long long)(scene.triangles.size() - baseTriangle), dt, dt > 0.0 ? ((double)file.Size() / (1024.0 * 1024.0)) / dt : 0.0);
+    return true;
+}
@@ -0,0 +1,26 @@
+#ifndef __MESHIMPORT_H
+#define __MESHIMPORT_H
+/**
+ * @file MeshImport.h
+ * @brief OBJ and PLY Mesh Importers
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-07
+*/
+#include "SceneDescription.h"
+
+namespace EDX {
+    namespace IO {
+        /**
+         * @brief Streams a triangle mesh from a Wavefront OBJ or binary PLY file into a scene's vertex and triangle tables.
+         * @param filePath Path to the mesh. The format is detected from the file's contents.
+         * @param material Material index assigned to every triangle.
+         * @param transform Transform index assigned to every triangle.
+         * @param scene The scene to append to. Vertices are appended after any existing vertices.
+         * @return false if the file couldn't be opened or is malformed. Nothing is appended on failure.
+         * @remark Polygons are triangulated as fans. Only positions and faces are imported; texture coordinates, normals and colours are ignored.
+        */
+        bool ImportMesh(const char* filePath, const uint32_t material, const uint32_t transform, SceneDescription& scene);
+    }
+}
+
+#endif
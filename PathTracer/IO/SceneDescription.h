@@ -0,0 +1,182 @@
+#ifndef __SCENEDESCRIPTION_H
+#define __SCENEDESCRIPTION_H
+/**
+ * @file SceneDescription.h
+ * @brief Format-independent Scene Description
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-06
+*/
+#include "../Containers/Span.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace EDX {
+    namespace IO {
+        //Records are plain arrays of floats and indices, so a description can be written to, or viewed directly from, a binary scene file.
+
+        struct SceneCamera {
+            float lookFrom[3];
+            float lookAt[3];
+            float up[3];
+            float fovDegrees;
+        };
+
+        struct SceneVertex {
+            float position[3];
+        };
+
+        struct SceneMaterial {
+            float ambient[4];
+            float diffuse[4];
+            float specular[4];
+            float emission[4];
+            float shininess;
+        };
+
+        /**
+         * @brief A composed world transform, in the same row-vector layout as Maths::Matrix4x4.
+        */
+        struct SceneTransform {
+            float m[16];
+        };
+
+        struct SceneTriangle {
+            uint32_t indices[3];    //Indices into the vertex array.
+            uint32_t material;      //Index into the material table.
+            uint32_t transform;     //Index into the transform table.
+        };
+
+        struct SceneSphere {
+            float centre[3];
+            float radius;
+            uint32_t material;
+            uint32_t transform;
+        };
+
+        struct SceneDirectionalLight {
+            float direction[3];
+            float colour[3];
+        };
+
+        struct ScenePointLight {
+            float position[3];
+            float attenuation[3];   //Constant, Linear, Quadratic
+            float colour[3];
+        };
+
+        enum ESceneIntegrator : uint32_t {
+            SCENE_INTEGRATOR_RAYTRACER = 0,     //Whitted-style ray tracing.
+            SCENE_INTEGRATOR_PATHTRACER,        //Monte Carlo path tracing.
+        };
+
+        enum ESceneSampling : uint32_t {
+            SCENE_SAMPLING_HEMISPHERE = 0,      //Uniform over the hemisphere.
+            SCENE_SAMPLING_COSINE,              //Cosine-weighted.
+            SCENE_SAMPLING_BRDF,                //In proportion to the material's BRDF.
+        };
+
+        enum ESceneSampler : uint32_t {
+            SCENE_SAMPLER_INDEPENDENT = 0,      //Uncorrelated random numbers.
+            SCENE_SAMPLER_SOBOL,                //Owen-scrambled Sobol points.
+        };
+
+        enum ESceneLightSampling : uint32_t {
+            SCENE_LIGHT_SAMPLING_ALL = 0,       //Every light is sampled at every hit.
+            SCENE_LIGHT_SAMPLING_TREE,          //Lights are chosen from a light hierarchy.
+            SCENE_LIGHT_SAMPLING_POWER,         //Lights are chosen in proportion to their power.
+        };
+
+        /**
+         * @brief Selects and configures the integrator a scene is rendered with.
+        */
+        struct SceneIntegrator {
+            uint32_t type;                  //ESceneIntegrator
+            uint32_t samplesPerPixel;       //Maximum number of samples taken per pixel.
+            uint32_t importanceSampling;    //ESceneSampling; how the path tracer chooses each bounce's direction.
+            uint32_t russianRoulette;       //Non-zero to end paths by Russian roulette, rather than at maxDepth.
+            float timeBudget;               //Seconds to spend refining the image before stopping early, or 0 for no limit.
+            float noiseThreshold;           //Estimated relative error at which to stop early, or 0 to take every sample.
+            float adaptiveThreshold;        //Relative error at which each pixel stops taking samples, or 0 to sample every pixel equally.
+            uint32_t sampler;               //ESceneSampler; how each sample's random numbers are generated.
+            uint32_t lightSampling;         //ESceneLightSampling; which lights are sampled at each hit.
+            uint32_t lightSamples;          //Number of lights chosen at each hit, unless every light is sampled.
+            uint32_t denoise;               //Non-zero to denoise the finished image, guided by first-hit feature buffers.
+            uint32_t reserved;              //Pads the record to a multiple of 8 bytes.
+        };
+
+        constexpr SceneIntegrator g_DefaultSceneIntegrator = { SCENE_INTEGRATOR_RAYTRACER, 1, SCENE_SAMPLING_BRDF, 1, 0.0f, 0.0f, 0.0f, SCENE_SAMPLER_SOBOL, SCENE_LIGHT_SAMPLING_ALL, 1, 0, 0 };
+
+        static_assert(sizeof(SceneVertex) == 12, "Vertices are stored as tightly-packed float[3].");
+        static_assert(sizeof(SceneMaterial) == 68, "SceneMaterial must not contain padding.");
+        static_assert(sizeof(SceneTriangle) == 20, "SceneTriangle must not contain padding.");
+        static_assert(sizeof(SceneSphere) == 24, "SceneSphere must not contain padding.");
+
+        /**
+         * @brief Non-owning view of a scene. Either references a SceneDescription, or a mapped binary scene file.
+        */
+        struct SceneView {
+            uint16_t width = 0;
+            uint16_t height = 0;
+            uint32_t maxDepth = 1;
+            bool hasCamera = false;
+            SceneCamera camera = {};
+            SceneIntegrator integrator = g_DefaultSceneIntegrator;
+            std::string_view outputName;
+            uint64_t geometryHash = 0;
+
+            Span<const SceneVertex> vertices;
+            Span<const SceneMaterial> materials;
+            Span<const SceneTransform> transforms;
+            Span<const SceneTriangle> triangles;
+            Span<const SceneSphere> spheres;
+            Span<const SceneDirectionalLight> directionalLights;
+            Span<const ScenePointLight> pointLights;
+        };
+
+        /**
+         * @brief Owning storage for a scene, as produced by parsing a text scene file.
+        */
+        struct SceneDescription {
+            uint16_t width = 0;
+            uint16_t height = 0;
+            uint32_t maxDepth = 1;
+            bool hasCamera = false;     //False if the scene doesn't define a camera, in which case the default is used.
+            SceneCamera camera = {};
+            SceneIntegrator integrator = g_DefaultSceneIntegrator;
+            std::string outputName;
+            uint64_t geometryHash = 0;  //Hash of the commands which define the scene's primitives.
+
+            std::vector<SceneVertex> vertices;
+            std::vector<SceneMaterial> materials;
+            std::vector<SceneTransform> transforms;
+            std::vector<SceneTriangle> triangles;
+            std::vector<SceneSphere> spheres;
+            std::vector<SceneDirectionalLight> directionalLights;
+            std::vector<ScenePointLight> pointLights;
+
+            SceneView View() const {
+                SceneView view;
+                view.width = width;
+                view.height = height;
+                view.maxDepth = maxDepth;
+                view.hasCamera = hasCamera;
+                view.camera = camera;
+                view.integrator = integrator;
+                view.outputName = outputName;
+                view.geometryHash = geometryHash;
+                view.vertices = vertices;
+                view.materials = materials;
+                view.transforms = transforms;
+                view.triangles = triangles;
+                view.spheres = spheres;
+                view.directionalLights = directionalLights;
+                view.pointLights = pointLights;
+                return view;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,198 @@
+#include "SceneParser.h"
+#include "../Utils/Hash.h"
+
+namespace {
+    struct CommandInfo {
+        std::string_view name;
+        EDX::IO::ESceneCommand type;
+        uint32_t numArgs;
+    };
+
+    //Ordered roughly by frequency, as large scenes are dominated by vertices and triangles.
+    constexpr CommandInfo g_Commands[] = {
+        { "vertex",         EDX::IO::ESceneCommand::Vertex,         3 },
+        { "tri",            EDX::IO::ESceneCommand::Tri,            3 },
+        { "sphere",         EDX::IO::ESceneCommand::Sphere,         4 },
+        { "translate",      EDX::IO::ESceneCommand::Translate,      3 },
+        { "rotate",         EDX::IO::ESceneCommand::Rotate,         4 },
+        { "scale",          EDX::IO::ESceneCommand::Scale,          3 },
+        { "pushTransform",  EDX::IO::ESceneCommand::PushTransform,  0 },
+        { "popTransform",   EDX::IO::ESceneCommand::PopTransform,   0 },
+        { "ambient",        EDX::IO::ESceneCommand::Ambient,        3 },
+        { "diffuse",        EDX::IO::ESceneCommand::Diffuse,        3 },
+        { "specular",       EDX::IO::ESceneCommand::Specular,       3 },
+        { "emission",       EDX::IO::ESceneCommand::Emission,       3 },
+        { "shininess",      EDX::IO::ESceneCommand::Shininess,      1 },
+        { "directional",    EDX::IO::ESceneCommand::Directional,    6 },
+        { "point",          EDX::IO::ESceneCommand::Point,          6 },
+        { "attenuation",    EDX::IO::ESceneCommand::Attenuation,    3 },
+        { "maxverts",       EDX::IO::ESceneCommand::MaxVerts,       1 },
+        { "size",           EDX::IO::ESceneCommand::Size,           2 },
+        { "camera",         EDX::IO::ESceneCommand::Camera,         10 },
+        { "output",         EDX::IO::ESceneCommand::Output,         1 },
+        { "maxdepth",       EDX::IO::ESceneCommand::MaxDepth,       1 },
+        { "mesh",           EDX::IO::ESceneCommand::Mesh,           1 },
+        { "integrator",     EDX::IO::ESceneCommand::Integrator,     1 },
+        { "spp",            EDX::IO::ESceneCommand::SamplesPerPixel, 1 },
+        { "importancesampling", EDX::IO::ESceneCommand::ImportanceSampling, 1 },
+        { "russianroulette", EDX::IO::ESceneCommand::RussianRoulette, 1 },
+        { "timebudget",     EDX::IO::ESceneCommand::TimeBudget,     1 },
+        { "noisethreshold", EDX::IO::ESceneCommand::NoiseThreshold, 1 },
+        { "adaptivethreshold", EDX::IO::ESceneCommand::AdaptiveThreshold, 1 },
+        { "sampler", EDX::IO::ESceneCommand::Sampler, 1 },
+        { "lightsampling", EDX::IO::ESceneCommand::LightSampling, 1 },
+        { "lightsamples", EDX::IO::ESceneCommand::LightSamples, 1 },
+        { "denoise", EDX::IO::ESceneCommand::Denoise, 1 },
+    };
+
+    inline bool IsIntegerCommand(const EDX::IO::ESceneCommand type) {
+        return type == EDX::IO::ESceneCommand::Size || type == EDX::IO::ESceneCommand::MaxVerts || type == EDX::IO::ESceneCommand::Tri || type == EDX::IO::ESceneCommand::SamplesPerPixel || type == EDX::IO::ESceneCommand::LightSamples;
+    }
+
+    //Commands whose argument is a file name or keyword, rather than a number.
+    inline bool IsStringCommand(const EDX::IO::ESceneCommand type) {
+        switch (type) {
+        case EDX::IO::ESceneCommand::Output:
+        case EDX::IO::ESceneCommand::Mesh:
+        case EDX::IO::ESceneCommand::Integrator:
+        case EDX::IO::ESceneCommand::ImportanceSampling:
+        case EDX::IO::ESceneCommand::RussianRoulette:
+        case EDX::IO::ESceneCommand::Sampler:
+        case EDX::IO::ESceneCommand::LightSampling:
+        case EDX::IO::ESceneCommand::Denoise:
+            return true;
+        default:
+            return false;
+        }
+    }
+}
+
+bool EDX::IO::ParseSceneLine(const std::string_view line, SceneCommand& command)
+{
+    uint64_t offset = 0;
+    const std::string_view name = NextToken(line, offset);
+
+    //Ignore blank lines and comments
+    if (name.empty() || name.front() == '#') {
+        return false;
+    }
+
+    command.type = ESceneCommand::Unknown;
+    command.numArgs = 0;
+    command.name = name;
+    command.argument = {};
+    command.hash = HashBytes(name.data(), name.size());
+
+    //Zero every argument up front, so short lines behave predictably.
+    memset(command.args, 0, sizeof(command.args));
+    memset(command.indices, 0, sizeof(command.indices));
+
+    for (const auto& info : g_Commands) {
+        if (info.name == name) {
+            command.type = info.type;
+            break;
+        }
+    }
+
+    const bool isInteger = IsIntegerCommand(command.type);
+    for (std::string_view token = NextToken(line, offset); !token.empty(); token = NextToken(line, offset)) {
+        //Tokens are separated by a space in the hash, so "1 23" and "12 3" differ.
+        command.hash = HashBytes(" ", 1, command.hash);
+        command.hash = HashBytes(token.data(), token.size(), command.hash);
+
+        if (command.numArgs == 0) {
+            command.argument = token;
+        }
+
+        if (isInteger) {
+            if (command.numArgs < 3) {
+                command.indices[command.numArgs] = ParseNumber<uint32_t>(token);
+            }
+        }
+        else if (command.numArgs < SceneCommand::MaxArgs && !IsStringCommand(command.type)) {
+            command.args[command.numArgs] = ParseNumber<float>(token);
+        }
+
+        command.numArgs++;
+    }
+
+    return true;
+}
+
+uint32_t EDX::IO::ExpectedArgCount(const ESceneCommand command)
+{
+    for (const auto& info : g_Commands) {
+        if (info.type == command) {
+            return info.numArgs;
+        }
+    }
+    return 0;
+}
+
+bool EDX::IO::IsViewCommand(const ESceneCommand command)
+{
+    switch (command) {
+    case ESceneCommand::Size:
+    case ESceneCommand::Camera:
+    case ESceneCommand::Output:
+    case ESceneCommand::MaxDepth:
+    case ESceneCommand::Directional:
+    case ESceneCommand::Point:
+    case ESceneCommand::Attenuation:
+    case ESceneCommand::Integrator:
+    case ESceneCommand::SamplesPerPixel:
+    case ESceneCommand::ImportanceSampling:
+    case ESceneCommand::RussianRoulette:
+    case ESceneCommand::TimeBudget:
+    case ESceneCommand::NoiseThreshold:
+    case ESceneCommand::AdaptiveThreshold:
+    case ESceneCommand::Sampler:
+    case ESceneCommand::LightSampling:
+    case ESceneCommand::LightSamples:
+    case ESceneCommand::Denoise:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void EDX::IO::SplitSceneChunks(const char* pBegin, const char* pEnd, const uint64_t chunkSize, std::vector<SceneChunk>& chunks)
+{
+    chunks.clear();
+    while (pBegin < pEnd) {
+        const char* pSplit = pEnd;
+        if ((uint64_t)(pEnd - pBegin) > chunkSize) {
+            //Extend the chunk to the end of the line it would otherwise split.
+            const char* pEOL = static_cast<const char*>(memchr(pBegin + chunkSize, '\n', pEnd - (pBegin + chunkSize)));
+            pSplit = pEOL ? pEOL + 1 : pEnd;
+        }
+
+        SceneChunk chunk = {};
+        chunk.pBegin = pBegin;
+        chunk.pEnd = pSplit;
+        chunks.push_back(std::move(chunk));
+
+        pBegin = pSplit;
+    }
+}
+
+void EDX::IO::ParseSceneChunk(SceneChunk& chunk)
+{
+    chunk.commands.clear();
+    chunk.lines.clear();
+    chunk.numLines = 0;
+
+    //Scene lines average ~30 bytes; reserving up front avoids most reallocations.
+    const uint64_t estimate = (chunk.pEnd - chunk.pBegin) / 24;
+    chunk.commands.reserve(estimate);
+    chunk.lines.reserve(estimate);
+
+    SceneCommand command = {};
+    ForEachLine(chunk.pBegin, chunk.pEnd, [&](const std::string_view line, const uint64_t lineNumber) {
+        chunk.numLines = lineNumber;
+        if (ParseSceneLine(line, command)) {
+            chunk.commands.push_back(command);
+            chunk.lines.push_back(static_cast<uint32_t>(lineNumber));
+        }
+    });
+}
@@ -0,0 +1,169 @@
+#ifndef __SCENEPARSER_H
+#define __SCENEPARSER_H
+/**
+ * @file SceneParser.h
+ * @brief Allocation-free Scene File Tokeniser
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-05
+*/
+#include <cstdint>
+#include <string_view>
+#include <cstring>
+#include <vector>
+#include <charconv>
+
+namespace EDX {
+    namespace IO {
+
+        enum class ESceneCommand : uint8_t {
+            Unknown = 0,
+            Size,
+            Camera,
+            Output,
+            MaxDepth,
+            Sphere,
+            MaxVerts,
+            Vertex,
+            Tri,
+            Directional,
+            Point,
+            Attenuation,
+            Ambient,
+            Diffuse,
+            Specular,
+            Emission,
+            Shininess,
+            PushTransform,
+            PopTransform,
+            Translate,
+            Rotate,
+            Scale,
+            Mesh,
+            Integrator,
+            SamplesPerPixel,
+            ImportanceSampling,
+            RussianRoulette,
+            TimeBudget,
+            NoiseThreshold,
+            AdaptiveThreshold,
+            Sampler,
+            LightSampling,
+            LightSamples,
+            Denoise,
+        };
+
+        inline bool IsWhitespace(const char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        /**
+         * @brief Returns the next whitespace-delimited token in line, starting from offset, and advances offset past it.
+         * @return An empty view once the end of the line is reached.
+        */
+        inline std::string_view NextToken(const std::string_view line, uint64_t& offset) {
+            while (offset < line.size() && IsWhitespace(line[offset])) {
+                offset++;
+            }
+            const uint64_t begin = offset;
+            while (offset < line.size() && !IsWhitespace(line[offset])) {
+                offset++;
+            }
+            return line.substr(begin, offset - begin);
+        }
+
+        /**
+         * @brief Converts a token to a number. Malformed tokens produce 0.
+         * @remark std::from_chars doesn't accept a leading '+', unlike std::stof, so it's skipped here.
+        */
+        template <typename T>
+        inline T ParseNumber(std::string_view token) {
+            if (!token.empty() && token.front() == '+') {
+                token.remove_prefix(1);
+            }
+            T value = 0;
+            std::from_chars(token.data(), token.data() + token.size(), value);
+            return value;
+        }
+
+        /**
+         * @brief A single parsed line of a scene file.
+         * @remark String views reference the source buffer, and are only valid for as long as it is.
+        */
+        struct SceneCommand {
+            static constexpr uint32_t MaxArgs = 10;
+
+            ESceneCommand type;
+            uint32_t numArgs;                   //Number of arguments present on the line.
+            float args[MaxArgs];                //Numeric arguments. Missing or malformed values are 0.
+            uint32_t indices[3];                //Integer arguments, for 'size', 'maxverts', 'tri' and 'spp'.
+            std::string_view name;              //The command's name, as written.
+            std::string_view argument;          //The first argument, as written. Used by 'output', 'mesh' and the integrator settings.
+            uint64_t hash;                      //FNV-1a hash of the line's tokens, ignoring whitespace.
+        };
+
+        /**
+         * @brief Parses a single line of a scene file.
+         * @param line The line to parse, without its trailing newline.
+         * @param command Receives the parsed command.
+         * @return false if the line is blank or a comment.
+        */
+        bool ParseSceneLine(std::string_view line, SceneCommand& command);
+
+        /**
+         * @brief Returns the number of arguments a command expects, or 0 for unknown commands.
+        */
+        uint32_t ExpectedArgCount(const ESceneCommand command);
+
+        /**
+         * @brief Returns true for commands which don't affect a scene's primitives, i.e. cameras, output and integrator settings, and lights.
+        */
+        bool IsViewCommand(const ESceneCommand command);
+
+        /**
+         * @brief A line-aligned section of a scene file, and the commands parsed from it.
+        */
+        struct SceneChunk {
+            const char* pBegin;
+            const char* pEnd;
+            uint64_t numLines;                      //Number of lines in the chunk, including blank lines and comments.
+            std::vector<SceneCommand> commands;     //Commands in the order they appear.
+            std::vector<uint32_t> lines;            //Line number of each command, relative to the start of the chunk.
+        };
+
+        /**
+         * @brief Splits [pBegin, pEnd) into chunks of roughly chunkSize bytes, with each chunk ending on a line boundary.
+        */
+        void SplitSceneChunks(const char* pBegin, const char* pEnd, const uint64_t chunkSize, std::vector<SceneChunk>& chunks);
+
+        /**
+         * @brief Parses every line of a chunk into its command buffer. Chunks are independent, so may be parsed concurrently.
+        */
+        void ParseSceneChunk(SceneChunk& chunk);
+
+        /**
+         * @brief Calls fn(line, lineNumber) for each line in [pBegin, pEnd), with any trailing '\r' removed.
+        */
+        template <typename Fn>
+        void ForEachLine(const char* pBegin, const char* pEnd, Fn&& fn) {
+            uint64_t lineNumber = 1;
+            while (pBegin < pEnd) {
+                const char* pEOL = static_cast<const char*>(memchr(pBegin, '\n', pEnd - pBegin));
+                if (!pEOL) {
+                    pEOL = pEnd;
+                }
+
+                std::string_view line(pBegin, pEOL - pBegin);
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+
+                fn(line, lineNumber);
+
+                lineNumber++;
+                pBegin = pEOL + 1;
+            }
+        }
+    }
+}
+
+#endif
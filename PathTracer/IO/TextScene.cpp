@@ -0,0 +1,426 @@
+#include "TextScene.h"
+#include "SceneParser.h"
+#include "MeshImport.h"
+#include "../Maths.h"
+#include "../Utils/Logger.h"
+#include "../Utils/Hash.h"
+#include "../Utils/ParallelFor.h"
+#include <stack>
+#include <thread>
+#include <filesystem>
+
+constexpr uint64_t g_SceneChunkSize = 256 * 1024;    //Bytes of scene file parsed per task.
+
+namespace {
+    using EDX::IO::ESceneCommand;
+
+    /**
+     * @brief Tracks the state set by stateful commands (materials, transforms, attenuation) while a text scene is applied.
+    */
+    class TextSceneBuilder {
+    public:
+        TextSceneBuilder(EDX::IO::SceneDescription& scene, const char* filePath) : m_Scene(scene) {
+            m_Directory = std::filesystem::path(filePath).parent_path();
+
+            m_Scene.geometryHash = EDX::g_FNVOffsetBasis;
+
+            m_Material = {};
+            m_Material.ambient[0] = m_Material.ambient[1] = m_Material.ambient[2] = 0.1f;
+            m_Material.ambient[3] = 1.0f;
+        }
+
+        /**
+         * @brief Applies a parsed command to the scene. Commands are stateful, so must be applied in file order.
+        */
+        void Apply(const EDX::IO::SceneCommand& cmd, const uint64_t lineNumber);
+
+    private:
+        /**
+         * @brief Returns the index of the current material, appending it to the material table if it has changed since it was last used.
+        */
+        uint32_t CurrentMaterial();
+
+        /**
+         * @brief Returns the index of the current composed transform, appending it to the transform table if it has changed since it was last used.
+         * @remark Every identity transform shares a single table entry.
+        */
+        uint32_t CurrentTransform();
+
+        /**
+         * @brief Applies a transform on top of the current transform. Transforms are applied to primitives in the reverse of the order they're specified in.
+        */
+        void ApplyTransform(const EDX::Maths::Matrix4x4<float>& transform);
+
+        EDX::IO::SceneDescription& m_Scene;
+        std::filesystem::path m_Directory;  //Directory containing the scene, which mesh paths are relative to.
+
+        //Index of each 'vertex' command's vertex in the scene. Meshes add vertices too, so 'tri' indices can't address the vertex table directly.
+        std::vector<uint32_t> m_TextVertices;
+
+        EDX::IO::SceneMaterial m_Material;
+        bool m_MaterialDirty = true;
+
+        std::stack<EDX::Maths::Matrix4x4<float>> m_TransformStack;
+        EDX::Maths::Matrix4x4<float> m_Transform;   //The composed transform; updated only by transform commands, rather than per primitive. 
+        bool m_TransformDirty = true;
+        uint32_t m_CurrentTransform = 0;
+        uint32_t m_IdentityTransform = UINT32_MAX;  //Index of the identity transform in the table, if it's been used. 
+
+        EDX::Maths::Vector3f m_Attenuation = { 1.0f, 0.0f, 0.0f };
+    };
+
+    inline void SetColour(float* pColour, const float* args) {
+        pColour[0] = args[0];
+        pColour[1] = args[1];
+        pColour[2] = args[2];
+        pColour[3] = 1.0f;
+    }
+}
+
+uint32_t TextSceneBuilder::CurrentMaterial()
+{
+    if (m_MaterialDirty) {
+        m_Scene.materials.push_back(m_Material);
+        m_MaterialDirty = false;
+    }
+    return static_cast<uint32_t>(m_Scene.materials.size() - 1);
+}
+
+uint32_t TextSceneBuilder::CurrentTransform()
+{
+    if (m_TransformDirty) {
+        const bool isIdentity = m_Transform.IsIdentity();
+        if (isIdentity && m_IdentityTransform != UINT32_MAX) {
+            m_CurrentTransform = m_IdentityTransform;
+        }
+        else {
+            EDX::IO::SceneTransform t;
+            memcpy(t.m, m_Transform.arr, sizeof(t.m));
+            m_Scene.transforms.push_back(t);
+
+            m_CurrentTransform = static_cast<uint32_t>(m_Scene.transforms.size() - 1);
+            if (isIdentity) {
+                m_IdentityTransform = m_CurrentTransform;
+            }
+        }
+        m_TransformDirty = false;
+    }
+    return m_CurrentTransform;
+}
+
+void TextSceneBuilder::ApplyTransform(const EDX::Maths::Matrix4x4<float>& transform)
+{
+    m_Transform = transform * m_Transform;
+    m_TransformDirty = true;
+}
+
+void TextSceneBuilder::Apply(const EDX::IO::SceneCommand& cmd, const uint64_t lineNumber)
+{
+    if (cmd.type == ESceneCommand::Unknown) {
+        EDX::Log::Warning("Unknown Command \"%.*s\" on line %llu.\n", (int)cmd.name.size(), cmd.name.data(), (unsigned long long)lineNumber);
+        return;
+    }
+
+    //Hash every command which affects the scene's primitives; cameras, output settings and lights can vary without changing the geometry.
+    if (!EDX::IO::IsViewCommand(cmd.type)) {
+        m_Scene.geometryHash = EDX::HashBytes(&cmd.hash, sizeof(cmd.hash), m_Scene.geometryHash);
+    }
+
+    const uint32_t expectedArgs = EDX::IO::ExpectedArgCount(cmd.type);
+    if (cmd.numArgs < expectedArgs) {
+        EDX::Log::Warning("Command \"%.*s\" on line %llu expects %u arguments, but only %u were given. Missing arguments default to 0.\n", (int)cmd.name.size(), cmd.name.data(), (unsigned long long)lineNumber, expectedArgs, cmd.numArgs);
+    }
+
+    const float* args = cmd.args;
+    switch (cmd.type) {
+        //The 'size' command specifies a render's size:
+        //size [x] [y]
+    case ESceneCommand::Size:
+        m_Scene.width = static_cast<uint16_t>(cmd.indices[0]);
+        m_Scene.height = static_cast<uint16_t>(cmd.indices[1]);
+        break;
+        //The 'camera' command defines a camera
+        //camera [lookFrom xyz] [lookAt xyz] [up xyz] [FoVDegrees]
+    case ESceneCommand::Camera:
+        memcpy(m_Scene.camera.lookFrom, args + 0, sizeof(float) * 3);
+        memcpy(m_Scene.camera.lookAt, args + 3, sizeof(float) * 3);
+        memcpy(m_Scene.camera.up, args + 6, sizeof(float) * 3);
+        m_Scene.camera.fovDegrees = args[9];
+        m_Scene.hasCamera = true;
+        break;
+        //The 'output' command specifies an output name.
+        //Extensions are stripped, and a timestamp is added during export.
+        //output [file name]
+    case ESceneCommand::Output:
+        m_Scene.outputName = std::string(cmd.argument);
+        break;
+        //The 'sphere' command defines a sphere
+        //sphere [position xyz] [radius]
+    case ESceneCommand::Sphere:
+    {
+        EDX::IO::SceneSphere s;
+        memcpy(s.centre, args, sizeof(float) * 3);
+        s.radius = args[3];
+        s.material = CurrentMaterial();
+        s.transform = CurrentTransform();
+        m_Scene.spheres.push_back(s);
+    }
+    break;
+    //The 'maxverts' command specifies the maximum number of vertices in this scene.
+    //Used for array sizing.
+    //maxverts [count]
+    case ESceneCommand::MaxVerts:
+        m_Scene.vertices.reserve(cmd.indices[0]);
+        m_TextVertices.reserve(cmd.indices[0]);
+        break;
+        //The 'vertex' command defines a vertex in the scene.
+        //Indexed by the 'tri' command to construct triangles.
+        //vertex [x] [y] [z]
+    case ESceneCommand::Vertex:
+        m_TextVertices.push_back(static_cast<uint32_t>(m_Scene.vertices.size()));
+        m_Scene.vertices.push_back({ args[0], args[1], args[2] });
+        break;
+        //The 'tri' command defines a triangle geometry.
+        //Defined by 3 vertices, a, b and c - indexed into the vertices array.
+        //tri [a] [b] [c]
+    case ESceneCommand::Tri:
+    {
+        const uint64_t numVertices = m_TextVertices.size();
+        if (cmd.indices[0] >= numVertices || cmd.indices[1] >= numVertices || cmd.indices[2] >= numVertices) {
+            EDX::Log::Warning("Triangle on line %llu references an undefined vertex (%llu defined), and was ignored.\n", (unsigned long long)lineNumber, (unsigned long long)numVertices);
+            break;
+        }
+
+        EDX::IO::SceneTriangle t;
+        t.indices[0] = m_TextVertices[cmd.indices[0]];
+        t.indices[1] = m_TextVertices[cmd.indices[1]];
+        t.indices[2] = m_TextVertices[cmd.indices[2]];
+        t.material = CurrentMaterial();
+        t.transform = CurrentTransform();
+        m_Scene.triangles.push_back(t);
+    }
+    break;
+    //The 'directional' command defines a Directional light
+    //Defined by a Direction and a colour.
+    //direction [dir xyz] [colour rgb]
+    case ESceneCommand::Directional:
+        m_Scene.directionalLights.push_back({ { args[0], args[1], args[2] }, { args[3], args[4], args[5] } });
+        break;
+    case ESceneCommand::Diffuse:
+        SetColour(m_Material.diffuse, args);
+        m_MaterialDirty = true;
+        break;
+    case ESceneCommand::Ambient:
+        SetColour(m_Material.ambient, args);
+        m_MaterialDirty = true;
+        break;
+    case ESceneCommand::Emission:
+        SetColour(m_Material.emission, args);
+        m_MaterialDirty = true;
+        break;
+    case ESceneCommand::Specular:
+        SetColour(m_Material.specular, args);
+        m_MaterialDirty = true;
+        break;
+    case ESceneCommand::Shininess:
+        m_Material.shininess = args[0];
+        m_MaterialDirty = true;
+        break;
+    case ESceneCommand::PushTransform:
+        m_TransformStack.push(m_Transform);
+        break;
+    case ESceneCommand::PopTransform:
+        if (m_TransformStack.empty()) {
+            EDX::Log::Warning("popTransform on line %llu has no matching pushTransform, and was ignored.\n", (unsigned long long)lineNumber);
+            break;
+        }
+        m_Transform = m_TransformStack.top();
+        m_TransformStack.pop();
+        m_TransformDirty = true;
+        break;
+    case ESceneCommand::Translate:
+        ApplyTransform(EDX::Maths::Matrix4x4<float>::Translation({ args[0], args[1], args[2] }));
+        break;
+    case ESceneCommand::Rotate:
+    {
+        const EDX::Maths::Vector3f axis = EDX::Maths::Vector3f::Normalize({ args[0], args[1], args[2] });
+        const float angle = EDX::Maths::DegToRad(args[3]);
+
+        EDX::Maths::Quaternion q;
+        q = q.FromAxisAngle(axis, angle);
+
+        ApplyTransform(q.ToMatrix4x4());
+    }
+    break;
+    case ESceneCommand::Scale:
+        ApplyTransform(EDX::Maths::Matrix4x4<float>::Scaling({ args[0], args[1], args[2] }));
+        break;
+    case ESceneCommand::Point:
+        m_Scene.pointLights.push_back({ { args[0], args[1], args[2] }, { m_Attenuation.x, m_Attenuation.y, m_Attenuation.z }, { args[3], args[4], args[5] } });
+        break;
+    case ESceneCommand::Attenuation:
+        m_Attenuation = { args[0], args[1], args[2] };
+        break;
+    case ESceneCommand::MaxDepth:
+        m_Scene.maxDepth = static_cast<uint32_t>(args[0]);
+        break;
+        //The 'mesh' command imports a triangle mesh from an OBJ or PLY file, with the current material and transform.
+        //Relative paths are resolved from the scene file's directory.
+        //mesh [file name]
+    case ESceneCommand::Mesh:
+    {
+        const std::filesystem::path meshPath = m_Directory / std::filesystem::path(std::string(cmd.argument));
+        const uint64_t baseVertex = m_Scene.vertices.size();
+        const uint64_t baseTriangle = m_Scene.triangles.size();
+        if (!EDX::IO::ImportMesh(meshPath.string().c_str(), CurrentMaterial(), CurrentTransform(), m_Scene)) {
+            EDX::Log::Warning("Mesh on line %llu could not be imported, and was ignored.\n", (unsigned long long)lineNumber);
+        }
+
+        //The same file name can refer to different meshes from different scenes' directories, so hash the imported data rather than just the command. 
+        m_Scene.geometryHash = EDX::HashBytes(m_Scene.vertices.data() + baseVertex, (m_Scene.vertices.size() - baseVertex) * sizeof(EDX::IO::SceneVertex), m_Scene.geometryHash);
+        m_Scene.geometryHash = EDX::HashBytes(m_Scene.triangles.data() + baseTriangle, (m_Scene.triangles.size() - baseTriangle) * sizeof(EDX::IO::SceneTriangle), m_Scene.geometryHash);
+    }
+    break;
+        //The 'integrator' command selects how the scene is rendered - 'raytracer' (Whitted-style, the default) or 'pathtracer'.
+        //integrator [name]
+    case ESceneCommand::Integrator:
+        if (cmd.argument == "raytracer") {
+            m_Scene.integrator.type = EDX::IO::SCENE_INTEGRATOR_RAYTRACER;
+        }
+        else if (cmd.argument == "pathtracer") {
+            m_Scene.integrator.type = EDX::IO::SCENE_INTEGRATOR_PATHTRACER;
+        }
+        else {
+            EDX::Log::Warning("Integrator \"%.*s\" on line %llu is unknown, and was ignored.\n", (int)cmd.argument.size(), cmd.argument.data(), (unsigned long long)lineNumber);
+        }
+        break;
+        //The 'spp' command specifies the maximum number of samples taken per pixel. Multiple samples are jittered within each pixel.
+        //spp [count]
+    case ESceneCommand::SamplesPerPixel:
+        m_Scene.integrator.samplesPerPixel = std::max(cmd.indices[0], 1u);
+        break;
+        //The 'importancesampling' command selects how the path tracer samples each bounce - 'hemisphere', 'cosine' or 'brdf' (the default).
+        //importancesampling [mode]
+    case ESceneCommand::ImportanceSampling:
+        if (cmd.argument == "hemisphere") {
+            m_Scene.integrator.importanceSampling = EDX::IO::SCENE_SAMPLING_HEMISPHERE;
+        }
+        else if (cmd.argument == "cosine") {
+            m_Scene.integrator.importanceSampling = EDX::IO::SCENE_SAMPLING_COSINE;
+        }
+        else if (cmd.argument == "brdf") {
+            m_Scene.integrator.importanceSampling = EDX::IO::SCENE_SAMPLING_BRDF;
+        }
+        else {
+            EDX::Log::Warning("Importance sampling mode \"%.*s\" on line %llu is unknown, and was ignored.\n", (int)cmd.argument.size(), cmd.argument.data(), (unsigned long long)lineNumber);
+        }
+        break;
+        //The 'russianroulette' command toggles whether paths are ended by Russian roulette (the default), or after maxdepth bounces.
+        //russianroulette [on|off]
+    case ESceneCommand::RussianRoulette:
+        m_Scene.integrator.russianRoulette = (cmd.argument == "on") ? 1 : 0;
+        break;
+        //The 'timebudget' command stops refining the image after a number of seconds, even if fewer than spp samples were taken.
+        //timebudget [seconds]
+    case ESceneCommand::TimeBudget:
+        m_Scene.integrator.timeBudget = std::max(args[0], 0.0f);
+        break;
+        //The 'noisethreshold' command stops refining the image once its estimated relative error falls below a threshold.
+        //noisethreshold [error]
+    case ESceneCommand::NoiseThreshold:
+        m_Scene.integrator.noiseThreshold = std::max(args[0], 0.0f);
+        break;
+        //The 'adaptivethreshold' command stops sampling each pixel once its own estimated relative error falls below a threshold.
+        //adaptivethreshold [error]
+    case ESceneCommand::AdaptiveThreshold:
+        m_Scene.integrator.adaptiveThreshold = std::max(args[0], 0.0f);
+        break;
+        //The 'sampler' command selects how each sample's random numbers are generated - 'independent', or 'sobol' (the default).
+        //sampler [type]
+    case ESceneCommand::Sampler:
+        if (cmd.argument == "independent") {
+            m_Scene.integrator.sampler = EDX::IO::SCENE_SAMPLER_INDEPENDENT;
+        }
+        else if (cmd.argument == "sobol") {
+            m_Scene.integrator.sampler = EDX::IO::SCENE_SAMPLER_SOBOL;
+        }
+        else {
+            EDX::Log::Warning("Sampler \"%.*s\" on line %llu is unknown, and was ignored.\n", (int)cmd.argument.size(), cmd.argument.data(), (unsigned long long)lineNumber);
+        }
+        break;
+        //The 'lightsampling' command selects which lights are sampled at each hit - 'all' of them (the default), or a few chosen from a light hierarchy ('tree'), or by their power ('power').
+        //lightsampling [mode]
+    case ESceneCommand::LightSampling:
+        if (cmd.argument == "all") {
+            m_Scene.integrator.lightSampling = EDX::IO::SCENE_LIGHT_SAMPLING_ALL;
+        }
+        else if (cmd.argument == "tree") {
+            m_Scene.integrator.lightSampling = EDX::IO::SCENE_LIGHT_SAMPLING_TREE;
+        }
+        else if (cmd.argument == "power") {
+            m_Scene.integrator.lightSampling = EDX::IO::SCENE_LIGHT_SAMPLING_POWER;
+        }
+        else {
+            EDX::Log::Warning("Light sampling mode \"%.*s\" on line %llu is unknown, and was ignored.\n", (int)cmd.argument.size(), cmd.argument.data(), (unsigned long long)lineNumber);
+        }
+        break;
+        //The 'lightsamples' command specifies how many lights are chosen at each hit, unless every light is sampled.
+        //lightsamples [count]
+    case ESceneCommand::LightSamples:
+        m_Scene.integrator.lightSamples = std::max(cmd.indices[0], 1u);
+        break;
+        //The 'denoise' command toggles whether the finished image is denoised (off by default), guided by the albedo, normal and depth of what each pixel's camera rays first hit.
+        //denoise [on|off]
+    case ESceneCommand::Denoise:
+        m_Scene.integrator.denoise = (cmd.argument == "on") ? 1 : 0;
+        break;
+    default:
+        break;
+    }
+}
+
+void EDX::IO::ParseTextScene(const char* filePath, const char* pData, const uint64_t size, SceneDescription& scene)
+{
+    TextSceneBuilder builder(scene, filePath);
+
+    //Split the file into line-aligned chunks, and parse them in waves across every thread.
+    //Each wave is then applied in file order, which bounds the memory held in parsed commands.
+    std::vector<SceneChunk> chunks;
+    SplitSceneChunks(pData, pData + size, g_SceneChunkSize, chunks);
+
+    const uint32_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    if (numThreads == 1 || chunks.size() == 1) {
+        //Buffering only pays off when chunks are parsed concurrently, so apply each line as it's parsed.
+        SceneCommand cmd = {};
+        ForEachLine(pData, pData + size, [&](const std::string_view line, const uint64_t lineNumber) {
+            if (ParseSceneLine(line, cmd)) {
+                builder.Apply(cmd, lineNumber);
+            }
+        });
+        return;
+    }
+
+    const uint64_t waveSize = (uint64_t)numThreads * 4;
+    uint64_t lineBase = 0;
+    for (uint64_t wave = 0; wave < chunks.size(); wave += waveSize) {
+        const uint64_t waveEnd = std::min<uint64_t>(wave + waveSize, chunks.size());
+
+        EDX::ParallelFor(waveEnd - wave, 1, [&](const uint64_t begin, const uint64_t end) {
+            for (uint64_t i = begin; i < end; i++) {
+                ParseSceneChunk(chunks[wave + i]);
+            }
+        });
+
+        for (uint64_t i = wave; i < waveEnd; i++) {
+            SceneChunk& chunk = chunks[i];
+            for (uint64_t c = 0; c < chunk.commands.size(); c++) {
+                builder.Apply(chunk.commands[c], lineBase + chunk.lines[c]);
+            }
+            lineBase += chunk.numLines;
+
+            //Release the chunk's buffers as soon as they've been applied.
+            chunk.commands = {};
+            chunk.lines = {};
+        }
+    }
+}
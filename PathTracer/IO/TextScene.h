@@ -0,0 +1,25 @@
+#ifndef __TEXTSCENE_H
+#define __TEXTSCENE_H
+/**
+ * @file TextScene.h
+ * @brief Text (.test) Scene File Loader
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-06
+*/
+#include "SceneDescription.h"
+
+namespace EDX {
+    namespace IO {
+        /**
+         * @brief Parses a text scene file into a scene description.
+         * @param filePath Path of the scene file. Meshes are loaded relative to its directory.
+         * @param pData Pointer to the file's contents. Need not be null-terminated.
+         * @param size Size of the file, in bytes.
+         * @param scene Receives the parsed scene.
+         * @remark Large files are split into line-aligned chunks and parsed across every hardware thread, then applied in file order.
+        */
+        void ParseTextScene(const char* filePath, const char* pData, const uint64_t size, SceneDescription& scene);
+    }
+}
+
+#endif
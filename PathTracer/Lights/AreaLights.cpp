@@ -0,0 +1,173 @@
+#include "AreaLights.h"
+#include "LightBVH.h"
+#include "../Maths/Sampling.h"
+#include <algorithm>
+#include <cmath>
+
+void EDX::AreaLights::Build(std::vector<Triangle>& triangles, std::vector<Sphere>& spheres)
+{
+    m_Emitters.clear();
+
+    //Weight each light by the power it emits; its radiance over its area.
+    std::vector<float> weights;
+    for (Triangle& t : triangles) {
+        const Colour& emission = t.GetMaterial()->emission;
+        const float power = LightPower(emission) * t.GetArea();
+        if (power > 0.0f) {
+            t.SetAreaLight(static_cast<uint32_t>(m_Emitters.size()));
+            Emitter emitter = {};
+            emitter.isTriangle = true;
+            t.GetWorldEdges(emitter.origin, emitter.edge1, emitter.edge2);
+            emitter.normal = t.GetNormal();
+            emitter.area = t.GetArea();
+            emitter.emission = emission;
+            m_Emitters.push_back(emitter);
+            weights.push_back(power);
+        }
+    }
+    for (Sphere& s : spheres) {
+        const Colour& emission = s.GetMaterial()->emission;
+        const float radius = s.GetWorldRadius();
+        const float power = LightPower(emission) * 4.0f * (float)Maths::PI * radius * radius;
+        if (s.IsWorldSphere() && power > 0.0f) {
+            s.SetAreaLight(static_cast<uint32_t>(m_Emitters.size()));
+            Emitter emitter = {};
+            emitter.isTriangle = false;
+            emitter.origin = s.GetWorldCentre();
+            emitter.radius = radius;
+            emitter.emission = emission;
+            m_Emitters.push_back(emitter);
+            weights.push_back(power);
+        }
+    }
+
+    m_PowerTable.Build(weights);
+}
+
+bool EDX::AreaLights::Sample(const Maths::Vector3f& point, const float u[3], AreaLightSample& sample) const
+{
+    uint32_t light = 0;
+    float pmf = 0.0f;
+    if (!m_PowerTable.Sample(u[0], light, pmf)) {
+        return false;
+    }
+
+    const Emitter& emitter = m_Emitters[light];
+    const bool isVisible = emitter.isTriangle ? SampleTriangle(emitter, point, u[1], u[2], sample) : SampleSphere(emitter, point, u[1], u[2], sample);
+    if (!isVisible) {
+        return false;
+    }
+
+    sample.pdf *= pmf;
+    sample.emission = emitter.emission;
+    return true;
+}
+
+float EDX::AreaLights::Pdf(const Maths::Vector3f& point, const RayHit& hit) const
+{
+    const Emitter& emitter = m_Emitters[hit.areaLight];
+    const float pmf = m_PowerTable.Pmf(hit.areaLight);
+
+    const Maths::Vector3f wi = hit.point - point;
+    const float distanceSquared = static_cast<float>(wi.LengthSquared());
+    const float cosLight = std::fabs(static_cast<float>(Maths::Vector3f::Dot(hit.normal, wi))) / std::sqrt(distanceSquared);
+
+    if (emitter.isTriangle) {
+        return cosLight > 0.0f ? pmf * distanceSquared / (cosLight * emitter.area) : 0.0f;
+    }
+
+    //Mirror SampleSphere(); by area from inside the sphere, or over the cone it subtends from outside. 
+    const float radiusSquared = emitter.radius * emitter.radius;
+    const float centreDistanceSquared = static_cast<float>((emitter.origin - point).LengthSquared());
+    if (centreDistanceSquared <= radiusSquared) {
+        return cosLight > 0.0f ? pmf * distanceSquared / (cosLight * 4.0f * (float)Maths::PI * radiusSquared) : 0.0f;
+    }
+
+    const float sinMaxSquared = radiusSquared / centreDistanceSquared;
+    const float cosMax = std::sqrt(std::max(0.0f, 1.0f - sinMaxSquared));
+    const float oneMinusCosMax = sinMaxSquared / (1.0f + cosMax);
+    return pmf / (2.0f * (float)Maths::PI * oneMinusCosMax);
+}
+
+uint32_t EDX::AreaLights::Size() const
+{
+    return static_cast<uint32_t>(m_Emitters.size());
+}
+
+bool EDX::AreaLights::SampleTriangle(const Emitter& triangle, const Maths::Vector3f& point, const float u1, const float u2, AreaLightSample& sample) const
+{
+    //Fold the unit square onto the triangle's barycentric coordinates; the square root keeps the density uniform. 
+    const float su = std::sqrt(u1);
+    const Maths::Vector3f p = triangle.origin + (triangle.edge1 * (su * (1.0f - u2))) + (triangle.edge2 * (su * u2));
+    Maths::Vector3f wi = p - point;
+    const float distanceSquared = static_cast<float>(wi.LengthSquared());
+    if (distanceSquared <= 0.0f) {
+        return false;
+    }
+    const float distance = std::sqrt(distanceSquared);
+    wi = wi / distance;
+
+    //Triangles are only hit from the front, so only emit from it.
+    const float cosLight = -static_cast<float>(Maths::Vector3f::Dot(triangle.normal, wi));
+    if (cosLight <= 0.0f) {
+        return false;
+    }
+
+    //Convert the density from area to solid angle.
+    sample.wi = wi;
+    sample.distance = distance;
+    sample.pdf = distanceSquared / (cosLight * triangle.area);
+    return true;
+}
+
+bool EDX::AreaLights::SampleSphere(const Emitter& sphere, const Maths::Vector3f& point, const float u1, const float u2, AreaLightSample& sample) const
+{
+    const Maths::Vector3f centre = sphere.origin;
+    const float radius = sphere.radius;
+    const Maths::Vector3f toCentre = centre - point;
+    const float distanceSquared = static_cast<float>(toCentre.LengthSquared());
+    const float radiusSquared = radius * radius;
+
+    if (distanceSquared <= radiusSquared) {
+        //Inside the sphere, every direction reaches it; sample its surface uniformly by area instead.
+        const float z = 1.0f - (2.0f * u1);
+        const float r = std::sqrt(std::max(0.0f, 1.0f - (z * z)));
+        const float phi = 2.0f * (float)Maths::PI * u2;
+        const Maths::Vector3f normal = { r * std::cos(phi), r * std::sin(phi), z };
+
+        Maths::Vector3f wi = (centre + (normal * radius)) - point;
+        const float lengthSquared = static_cast<float>(wi.LengthSquared());
+        const float cosLight = std::fabs(static_cast<float>(Maths::Vector3f::Dot(normal, wi)));
+        if (lengthSquared <= 0.0f || cosLight <= 0.0f) {
+            return false;
+        }
+        const float length = std::sqrt(lengthSquared);
+
+        sample.wi = wi / length;
+        sample.distance = length;
+        sample.pdf = lengthSquared * length / (cosLight * 4.0f * (float)Maths::PI * radiusSquared);
+        return true;
+    }
+
+    //Sample the cone of directions the sphere subtends. 1 - cos(thetaMax) is computed from sin^2(thetaMax), so small, distant lights don't round to an empty cone.
+    const float distance = std::sqrt(distanceSquared);
+    const float sinMaxSquared = radiusSquared / distanceSquared;
+    const float cosMax = std::sqrt(std::max(0.0f, 1.0f - sinMaxSquared));
+    const float oneMinusCosMax = sinMaxSquared / (1.0f + cosMax);
+
+    const float oneMinusCos = u1 * oneMinusCosMax;
+    const float cosTheta = 1.0f - oneMinusCos;
+    const float sinThetaSquared = oneMinusCos * (2.0f - oneMinusCos);
+    const float sinTheta = std::sqrt(std::max(0.0f, sinThetaSquared));
+    const float phi = 2.0f * (float)Maths::PI * u2;
+
+    const Maths::Vector3f axis = toCentre / distance;
+    Maths::Vector3f tangent, bitangent;
+    Maths::OrthonormalBasis(axis, tangent, bitangent);
+
+    //The nearer intersection of the sampled direction with the sphere.
+    sample.wi = Maths::FromLocal({ sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta }, tangent, bitangent, axis);
+    sample.distance = (distance * cosTheta) - std::sqrt(std::max(0.0f, radiusSquared - (distanceSquared * sinThetaSquared)));
+    sample.pdf = 1.0f / (2.0f * (float)Maths::PI * oneMinusCosMax);
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef __AREALIGHTS_H
+#define __AREALIGHTS_H
+/**
+ * @file AreaLights.h
+ * @brief Emissive Geometry, Sampled as Area Lights
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-15
+*/
+#include "../Primitives/Triangle.h"
+#include "../Primitives/Sphere.h"
+#include "../Utils/AliasTable.h"
+#include <vector>
+
+namespace EDX {
+    /**
+     * @brief A direction towards a point on an area light.
+    */
+    struct AreaLightSample {
+        Maths::Vector3f wi;     //Unit direction from the shading point to the light.
+        float distance;         //Distance along wi to the light.
+        float pdf;              //Probability density of choosing this direction, with respect to solid angle, including the choice of light.
+        Colour emission;        //Radiance leaving the light towards the shading point.
+    };
+
+    /**
+     * @brief The scene's emissive triangles and spheres, which are sampled directly rather than waiting for paths to hit them.
+     * @remark A light is chosen in proportion to its emitted power, then a point on it: uniformly by area for triangles, and uniformly within the cone the sphere subtends for spheres.
+     * Spheres transformed into ellipsoids aren't sampled, so their emission is still only gathered by the paths which hit them.
+    */
+    class AreaLights {
+    public:
+        /**
+         * @brief Collects the emissive primitives, and marks each with its index so hits on them can be recognised.
+         * @remark Each light keeps its own copy of the geometry it samples, so the primitives may be moved or released afterwards.
+        */
+        void Build(std::vector<Triangle>& triangles, std::vector<Sphere>& spheres);
+
+        /**
+         * @brief Chooses a point on an area light, as seen from a shading point.
+         * @param u Three uniform random numbers in [0, 1); the first chooses the light, and the others the point on it.
+         * @return false if there are no area lights, or the chosen one can't be seen from the point.
+        */
+        bool Sample(const Maths::Vector3f& point, const float u[3], AreaLightSample& sample) const;
+
+        /**
+         * @brief Returns the probability density of Sample() choosing the direction from a shading point to a hit on an area light, with respect to solid angle.
+         * @param hit A hit on one of the lights, as the nearest hit along the direction.
+        */
+        float Pdf(const Maths::Vector3f& point, const RayHit& hit) const;
+
+        uint32_t Size() const;
+
+    private:
+        /**
+         * @brief A light's world-space geometry. Triangles use origin, edges, normal and area; spheres use origin as their centre, and radius. 
+        */
+        struct Emitter {
+            bool isTriangle;
+            Maths::Vector3f origin;
+            Maths::Vector3f edge1;
+            Maths::Vector3f edge2;
+            Maths::Vector3f normal;
+            float area;
+            float radius;
+            Colour emission;
+        };
+
+        bool SampleTriangle(const Emitter& triangle, const Maths::Vector3f& point, const float u1, const float u2, AreaLightSample& sample) const;
+        bool SampleSphere(const Emitter& sphere, const Maths::Vector3f& point, const float u1, const float u2, AreaLightSample& sample) const;
+
+        std::vector<Emitter> m_Emitters;
+        AliasTable m_PowerTable;
+    };
+}
+#endif
@@ -0,0 +1,152 @@
+#include "LightBVH.h"
+#include <algorithm>
+#include <cmath>
+
+constexpr float g_OneMinusEpsilon = 0x1.fffffep-1f;    //Largest float below 1, for remapping samples.
+constexpr float g_MinAttenuation = 1e-4f;               //Prevents lights with no attenuation at all from dividing by zero.
+
+void EDX::LightBVH::Build(const std::vector<DirectionalLight>& directionalLights, const std::vector<PointLight>& pointLights)
+{
+    m_Nodes.clear();
+    m_DirectionalCount = static_cast<uint32_t>(directionalLights.size());
+
+    if (pointLights.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> lights(pointLights.size());
+    for (uint32_t i = 0; i < lights.size(); i++) {
+        lights[i] = i;
+    }
+
+    m_Nodes.reserve((2 * pointLights.size()) - 1);
+    BuildNode(lights, 0, static_cast<uint32_t>(lights.size()), pointLights);
+}
+
+uint32_t EDX::LightBVH::BuildNode(std::vector<uint32_t>& lights, const uint32_t begin, const uint32_t end, const std::vector<PointLight>& pointLights)
+{
+    const uint32_t nodeIndex = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes.push_back({});
+
+    if (end - begin == 1) {
+        const PointLight& light = pointLights[lights[begin]];
+        m_Nodes[nodeIndex] = { light.GetPosition(), light.GetPosition(), light.GetAttenuation(), LightPower(light.GetColour()), lights[begin], 1 };
+        return nodeIndex;
+    }
+
+    //Split the lights at the median along the longest axis of their bounds.
+    Maths::Vector3f boundsMin = pointLights[lights[begin]].GetPosition();
+    Maths::Vector3f boundsMax = boundsMin;
+    for (uint32_t i = begin + 1; i < end; i++) {
+        const Maths::Vector3f p = pointLights[lights[i]].GetPosition();
+        for (int axis = 0; axis < 3; axis++) {
+            boundsMin.arr[axis] = std::min(boundsMin.arr[axis], p.arr[axis]);
+            boundsMax.arr[axis] = std::max(boundsMax.arr[axis], p.arr[axis]);
+        }
+    }
+
+    const Maths::Vector3f extent = boundsMax - boundsMin;
+    int axis = 0;
+    if (extent.y > extent.arr[axis]) { axis = 1; }
+    if (extent.z > extent.arr[axis]) { axis = 2; }
+
+    const uint32_t mid = begin + ((end - begin) / 2);
+    std::nth_element(lights.begin() + begin, lights.begin() + mid, lights.begin() + end, [&](const uint32_t a, const uint32_t b) {
+        return pointLights[a].GetPosition().arr[axis] < pointLights[b].GetPosition().arr[axis];
+    });
+
+    const uint32_t left = BuildNode(lights, begin, mid, pointLights);
+    const uint32_t right = BuildNode(lights, mid, end, pointLights);
+
+    const Node& a = m_Nodes[left];
+    const Node& b = m_Nodes[right];
+    Node node = {};
+    for (int i = 0; i < 3; i++) {
+        node.boundsMin.arr[i] = std::min(a.boundsMin.arr[i], b.boundsMin.arr[i]);
+        node.boundsMax.arr[i] = std::max(a.boundsMax.arr[i], b.boundsMax.arr[i]);
+        node.attenuation.arr[i] = std::min(a.attenuation.arr[i], b.attenuation.arr[i]);
+    }
+    node.power = a.power + b.power;
+    node.index = right;
+    node.isLeaf = 0;
+
+    m_Nodes[nodeIndex] = node;
+    return nodeIndex;
+}
+
+float EDX::LightBVH::Importance(const Node& node, const Maths::Vector3f& point, const Maths::Vector3f& normal) const
+{
+    //Bound the node by a sphere, and measure to its centre.
+    const Maths::Vector3f centre = (node.boundsMin + node.boundsMax) * 0.5f;
+    const Maths::Vector3f toCentre = centre - point;
+    const float distanceSquared = static_cast<float>(toCentre.LengthSquared());
+    const float radiusSquared = static_cast<float>((node.boundsMax - node.boundsMin).LengthSquared()) * 0.25f;
+
+    //The smallest angle between the normal and any direction into the sphere bounds the cosine term.
+    float cosTheta = 1.0f;
+    if (distanceSquared > radiusSquared) {
+        const float distance = std::sqrt(distanceSquared);
+        const float cosI = static_cast<float>(Maths::Vector3f::Dot(normal, toCentre)) / distance;
+        const float sinI = std::sqrt(std::max(1.0f - (cosI * cosI), 0.0f));
+        const float sinB = std::sqrt(radiusSquared / distanceSquared);
+        const float cosB = std::sqrt(1.0f - (radiusSquared / distanceSquared));
+
+        if (cosI < cosB) {
+            cosTheta = (cosI * cosB) + (sinI * sinB);
+            if (cosTheta <= 0.0f) {
+                return 0.0f;    //Every light in the node is behind the surface.
+            }
+        }
+    }
+
+    //Lights inside the bounds may be closer than its centre; don't let them appear any closer than its radius.
+    const float distance = std::sqrt(std::max(distanceSquared, radiusSquared));
+    const Maths::Vector3f& att = node.attenuation;
+    const float attenuation = std::max(att.x + (att.y * distance) + (att.z * distance * distance), g_MinAttenuation);
+
+    return node.power * cosTheta / attenuation;
+}
+
+bool EDX::LightBVH::Sample(const Maths::Vector3f& point, const Maths::Vector3f& normal, float u, LightSample& sample) const
+{
+    const uint32_t choices = m_DirectionalCount + (m_Nodes.empty() ? 0 : 1);
+    if (choices == 0) {
+        return false;
+    }
+
+    //Choose a directional light, or the hierarchy, uniformly; then reuse the sample to descend it.
+    const uint32_t choice = std::min(static_cast<uint32_t>(u * (float)choices), choices - 1);
+    float pmf = 1.0f / (float)choices;
+    if (choice < m_DirectionalCount) {
+        sample = { choice, pmf };
+        return true;
+    }
+    u = std::min((u * (float)choices) - (float)choice, g_OneMinusEpsilon);
+
+    //Descend towards each child in proportion to its importance.
+    uint32_t nodeIndex = 0;
+    while (!m_Nodes[nodeIndex].isLeaf) {
+        const uint32_t left = nodeIndex + 1;
+        const uint32_t right = m_Nodes[nodeIndex].index;
+        const float leftImportance = Importance(m_Nodes[left], point, normal);
+        const float rightImportance = Importance(m_Nodes[right], point, normal);
+        if (leftImportance + rightImportance <= 0.0f) {
+            return false;
+        }
+
+        const float pLeft = leftImportance / (leftImportance + rightImportance);
+        if (u < pLeft) {
+            nodeIndex = left;
+            u = std::min(u / pLeft, g_OneMinusEpsilon);
+            pmf *= pLeft;
+        }
+        else {
+            nodeIndex = right;
+            u = std::min((u - pLeft) / (1.0f - pLeft), g_OneMinusEpsilon);
+            pmf *= 1.0f - pLeft;
+        }
+    }
+
+    sample = { m_DirectionalCount + m_Nodes[nodeIndex].index, pmf };
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef __LIGHTBVH_H
+#define __LIGHTBVH_H
+/**
+ * @file LightBVH.h
+ * @brief Light Hierarchy, for Sampling Many Lights
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-15
+*/
+#include "DirectionalLight.h"
+#include "PointLight.h"
+#include <vector>
+
+namespace EDX {
+    /**
+     * @brief Summarises a light's colour as a single power, for weighting lights against each other.
+    */
+    inline float LightPower(const Colour& colour) {
+        return (colour.r + colour.g + colour.b) / 3.0f;
+    }
+
+    /**
+     * @brief A light chosen for a shading point.
+    */
+    struct LightSample {
+        uint32_t light;     //Index into the scene's directional lights, followed by its point lights.
+        float pmf;          //Probability that this light was chosen.
+    };
+
+    /**
+     * @brief A bounding volume hierarchy over a scene's point lights, which picks a light for a shading point in proportion to an estimate of its contribution.
+     * @remark Each node bounds its lights' positions, total power and weakest attenuation, so whole groups of distant or back-facing lights are rejected together, and sampling takes O(log n) time.
+     * Directional lights can't be bounded, so are chosen uniformly, alongside the hierarchy as a whole.
+    */
+    class LightBVH {
+    public:
+        void Build(const std::vector<DirectionalLight>& directionalLights, const std::vector<PointLight>& pointLights);
+
+        /**
+         * @brief Chooses a light to illuminate a point.
+         * @param u A uniform sample in [0, 1).
+         * @return false if there are no lights, or the sample chose the hierarchy and none of its point lights can illuminate the point; a directional light may still have been chosen by another sample.
+        */
+        bool Sample(const Maths::Vector3f& point, const Maths::Vector3f& normal, float u, LightSample& sample) const;
+
+    private:
+        struct Node {
+            Maths::Vector3f boundsMin;
+            Maths::Vector3f boundsMax;
+            Maths::Vector3f attenuation;    //Smallest constant, linear and quadratic attenuation of any light in the node.
+            float power;                    //Total power of the node's lights.
+            uint32_t index;                 //For leaves, the point light's index; otherwise, the second child's index. The first child follows its parent.
+            uint32_t isLeaf;
+        };
+
+        uint32_t BuildNode(std::vector<uint32_t>& lights, const uint32_t begin, const uint32_t end, const std::vector<PointLight>& pointLights);
+
+        /**
+         * @brief Estimates the most a node's lights could contribute to a point, without visibility.
+        */
+        float Importance(const Node& node, const Maths::Vector3f& point, const Maths::Vector3f& normal) const;
+
+        std::vector<Node> m_Nodes;
+        uint32_t m_DirectionalCount = 0;
+    };
+}
+#endif
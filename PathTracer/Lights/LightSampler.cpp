@@ -0,0 +1,39 @@
+#include "LightSampler.h"
+#include <algorithm>
+
+constexpr float g_MinAttenuation = 1e-4f;   //Prevents lights with no attenuation at all from dividing by zero.
+
+void EDX::LightSampler::Build(const ELightSampling mode, const std::vector<DirectionalLight>& directionalLights, const std::vector<PointLight>& pointLights, const float sceneRadius)
+{
+    m_Mode = mode;
+
+    if (mode == ELightSampling::Tree) {
+        m_Tree.Build(directionalLights, pointLights);
+    }
+    else if (mode == ELightSampling::Power) {
+        //Weight each light by the irradiance it would deliver across the scene; directional lights don't attenuate.
+        std::vector<float> weights;
+        weights.reserve(directionalLights.size() + pointLights.size());
+        for (const DirectionalLight& light : directionalLights) {
+            weights.push_back(LightPower(light.GetColour()));
+        }
+        for (const PointLight& light : pointLights) {
+            const Maths::Vector3f& att = light.GetAttenuation();
+            const float attenuation = std::max(att.x + (att.y * sceneRadius) + (att.z * sceneRadius * sceneRadius), g_MinAttenuation);
+            weights.push_back(LightPower(light.GetColour()) / attenuation);
+        }
+        m_PowerTable.Build(weights);
+    }
+}
+
+bool EDX::LightSampler::Sample(const Maths::Vector3f& point, const Maths::Vector3f& normal, const float u, LightSample& sample) const
+{
+    switch (m_Mode) {
+    case ELightSampling::Tree:
+        return m_Tree.Sample(point, normal, u, sample);
+    case ELightSampling::Power:
+        return m_PowerTable.Sample(u, sample.light, sample.pmf);
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef __LIGHTSAMPLER_H
+#define __LIGHTSAMPLER_H
+/**
+ * @file LightSampler.h
+ * @brief Stochastic Light Selection
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-15
+*/
+#include "LightBVH.h"
+#include "../Utils/AliasTable.h"
+
+namespace EDX {
+    enum class ELightSampling : uint32_t {
+        All = 0,            //Every light, at every hit.
+        Tree,               //Lights chosen from a light hierarchy, in proportion to their estimated contribution.
+        Power,              //Lights chosen in proportion to their power, regardless of the shading point.
+    };
+
+    /**
+     * @brief Chooses lights for shading points, with the strategy selected by a scene.
+    */
+    class LightSampler {
+    public:
+        /**
+         * @param sceneRadius Typical distance from a light to the surfaces it lights, at which point lights' attenuation is measured for the Power strategy.
+        */
+        void Build(const ELightSampling mode, const std::vector<DirectionalLight>& directionalLights, const std::vector<PointLight>& pointLights, const float sceneRadius);
+
+        /**
+         * @brief Chooses a light to illuminate a point.
+         * @param u A uniform sample in [0, 1).
+         * @return false if there are no lights, or the sample chose a group of lights none of which can illuminate the point. Other samples may still choose a light which can.
+        */
+        bool Sample(const Maths::Vector3f& point, const Maths::Vector3f& normal, const float u, LightSample& sample) const;
+
+    private:
+        ELightSampling m_Mode = ELightSampling::All;
+        LightBVH m_Tree;
+        AliasTable m_PowerTable;    //Over the directional lights, followed by the point lights.
+    };
+}
+#endif
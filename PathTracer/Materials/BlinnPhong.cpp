@@ -0,0 +1,68 @@
+#include "BlinnPhong.h"
+#include "../Maths/Sampling.h"
+
+EDX::Colour EDX::BlinnPhong::Evaluate(const Maths::Vector3f& n, const Maths::Vector3f& wo, const Maths::Vector3f& wi) const
+{
+    const Maths::Vector3f h = (wo + wi).Normalize();
+    const float n_dot_h = std::max(static_cast<float>(Maths::Vector3f::Dot(n, h)), 0.0f);
+
+    //(s + 8) / 8PI keeps the lobe's reflectance roughly constant as it narrows. 
+    const float specularScale = ((shininess + 8.0f) / (8.0f * (float)Maths::PI)) * std::pow(n_dot_h, shininess);
+
+    return (diffuse * (1.0f / (float)Maths::PI)) + (specular * specularScale);
+}
+
+float EDX::BlinnPhong::SpecularProbability() const
+{
+    const float kd = diffuse.r + diffuse.g + diffuse.b;
+    const float ks = specular.r + specular.g + specular.b;
+    if (kd + ks <= 0.0f) {
+        return 0.0f;
+    }
+    return ks / (kd + ks);
+}
+
+bool EDX::BlinnPhong::Sample(const Maths::Vector3f& n, const Maths::Vector3f& wo, const float u[3], Maths::Vector3f& wi) const
+{
+    Maths::Vector3f tangent, bitangent;
+    Maths::OrthonormalBasis(n, tangent, bitangent);
+
+    if (u[0] < SpecularProbability()) {
+        //Sample a half vector about the normal in proportion to cos^s, then reflect wo about it. 
+        const float cosTheta = std::pow(u[1], 1.0f / (shininess + 1.0f));
+        const float sinTheta = sqrtf(std::max(0.0f, 1.0f - (cosTheta * cosTheta)));
+        const float phi = 2.0f * (float)Maths::PI * u[2];
+
+        const Maths::Vector3f h = Maths::FromLocal({ sinTheta * cosf(phi), sinTheta * sinf(phi), cosTheta }, tangent, bitangent, n);
+        wi = (h * (2.0f * static_cast<float>(Maths::Vector3f::Dot(wo, h)))) - wo;
+    }
+    else {
+        wi = Maths::FromLocal(Maths::CosineHemisphere(u[1], u[2]), tangent, bitangent, n);
+    }
+
+    return Maths::Vector3f::Dot(n, wi) > 0.0;
+}
+
+float EDX::BlinnPhong::Pdf(const Maths::Vector3f& n, const Maths::Vector3f& wo, const Maths::Vector3f& wi) const
+{
+    const float n_dot_wi = static_cast<float>(Maths::Vector3f::Dot(n, wi));
+    if (n_dot_wi <= 0.0f) {
+        return 0.0f;
+    }
+
+    const float specularProbability = SpecularProbability();
+    float pdf = (1.0f - specularProbability) * n_dot_wi / (float)Maths::PI;
+
+    if (specularProbability > 0.0f) {
+        //The half vector's density is (s + 1) / 2PI * cos^s; reflecting about it scales the density by 1 / (4 * wo.h). 
+        const Maths::Vector3f h = (wo + wi).Normalize();
+        const float n_dot_h = std::max(static_cast<float>(Maths::Vector3f::Dot(n, h)), 0.0f);
+        const float wo_dot_h = static_cast<float>(Maths::Vector3f::Dot(wo, h));
+        if (wo_dot_h > 0.0f) {
+            const float pdf_h = ((shininess + 1.0f) / (2.0f * (float)Maths::PI)) * std::pow(n_dot_h, shininess);
+            pdf += specularProbability * pdf_h / (4.0f * wo_dot_h);
+        }
+    }
+
+    return pdf;
+}
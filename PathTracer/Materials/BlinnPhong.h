@@ -7,6 +7,7 @@
  * @date 2024-08-29
 */
 #include "../Colour.h"
+#include "../Maths/Vector3.h"
 namespace EDX {
     struct BlinnPhong {
         Colour ambient; 
@@ -14,6 +15,31 @@ namespace EDX {
         Colour specular; 
         Colour emission; 
         float shininess; 
+
+        //The path tracer treats the material as a Lambertian diffuse lobe plus an energy-normalized Blinn-Phong specular lobe. 
+        //Every direction is normalized, and points away from the surface. 
+
+        /**
+         * @brief Evaluates the BRDF for light arriving from wi and leaving towards wo.
+        */
+        Colour Evaluate(const Maths::Vector3f& n, const Maths::Vector3f& wo, const Maths::Vector3f& wi) const;
+
+        /**
+         * @brief Returns the probability that Sample() chooses the specular lobe, in proportion to its reflectance.
+        */
+        float SpecularProbability() const;
+
+        /**
+         * @brief Samples an incoming direction in proportion to the diffuse and specular lobes.
+         * @param u Three uniform random numbers in [0, 1); the first chooses the lobe.
+         * @return false if the sampled direction is below the surface.
+        */
+        bool Sample(const Maths::Vector3f& n, const Maths::Vector3f& wo, const float u[3], Maths::Vector3f& wi) const;
+
+        /**
+         * @brief Returns the probability density of Sample() producing wi, with respect to solid angle.
+        */
+        float Pdf(const Maths::Vector3f& n, const Maths::Vector3f& wo, const Maths::Vector3f& wi) const;
     };
 }
-#endif
\ No newline at end of file
+#endif
@@ -50,55 +50,76 @@ namespace EDX {
                 return !(*this == rhs); 
             }
 
-            friend Vector4<T> operator *(const Vector4<T>& lhs, const Matrix4x4& rhs) {
-                Vector4<T> vec;
-                Matrix4x4 b = Matrix4x4::Transpose(rhs); 
-
-                vec[0] = Vector4f::Dot(lhs, b.vec[0]);
-                vec[1] = Vector4f::Dot(lhs, b.vec[1]);
-                vec[2] = Vector4f::Dot(lhs, b.vec[2]);
-                vec[3] = Vector4f::Dot(lhs, b.vec[3]);
-            
-                return vec;
+            /**
+             * @return true if this matrix is exactly the identity. 
+            */
+            bool IsIdentity() const {
+                for (uint8_t i = 0; i < 16; i++) {
+                    if (arr[i] != ((i % 5 == 0) ? T(1) : T(0))) {
+                        return false;
+                    }
+                }
+                return true;
             }
 
-            friend Vector4<T> operator *(const Matrix4x4& rhs, Vector4<T>& lhs) {
-                Vector4<T> vec;
-                Matrix4x4 b = Matrix4x4::Transpose(rhs);
-
-                vec[0] = lhs.Dot(b.vec[0]);
-                vec[1] = lhs.Dot(b.vec[1]);
-                vec[2] = lhs.Dot(b.vec[2]);
-                vec[3] = lhs.Dot(b.vec[3]);
+            /**
+             * @return true if this matrix is exactly a translation, i.e. the identity apart from its translation row. 
+            */
+            bool IsTranslation() const {
+                for (uint8_t i = 0; i < 12; i++) {
+                    if (arr[i] != ((i % 5 == 0) ? T(1) : T(0))) {
+                        return false;
+                    }
+                }
+                return arr[15] == T(1);
+            }
 
-                return vec;
+            friend Vector4<T> operator *(const Vector4<T>& lhs, const Matrix4x4& rhs) {
+                return rhs.CombineRows(lhs.x, lhs.y, lhs.z, lhs.w);
             }
 
-            friend Matrix4x4 operator *(Matrix4x4& lhs, const Matrix4x4& rhs) {
-                Matrix4x4 mat = {};
-                Matrix4x4 b = Matrix4x4::Transpose(rhs);
+            friend Vector4<T> operator *(const Matrix4x4& rhs, const Vector4<T>& lhs) {
+                return rhs.CombineRows(lhs.x, lhs.y, lhs.z, lhs.w);
+            }
 
-                mat.arr[0] = lhs.vec[0].Dot(b.vec[0]);
-                mat.arr[1] = lhs.vec[0].Dot(b.vec[1]);
-                mat.arr[2] = lhs.vec[0].Dot(b.vec[2]);
-                mat.arr[3] = lhs.vec[0].Dot(b.vec[3]);
+            friend Matrix4x4 operator *(const Matrix4x4& lhs, const Matrix4x4& rhs) {
+                //Each row of the product is the corresponding row of lhs, transformed by rhs.
+                Matrix4x4 mat;
+                for (uint8_t i = 0; i < 4; i++) {
+                    mat.vec[i] = rhs.CombineRows(lhs.vec[i].x, lhs.vec[i].y, lhs.vec[i].z, lhs.vec[i].w);
+                }
 
-                mat.arr[4] = lhs.vec[1].Dot(b.vec[0]);
-                mat.arr[5] = lhs.vec[1].Dot(b.vec[1]);
-                mat.arr[6] = lhs.vec[1].Dot(b.vec[2]);
-                mat.arr[7] = lhs.vec[1].Dot(b.vec[3]);
+                return mat;
+            }
 
-                mat.arr[8] = lhs.vec[2].Dot(b.vec[0]);
-                mat.arr[9] = lhs.vec[2].Dot(b.vec[1]);
-                mat.arr[10] = lhs.vec[2].Dot(b.vec[2]);
-                mat.arr[11] = lhs.vec[2].Dot(b.vec[3]);
+            /**
+             * @brief Transforms a point, treating it as {x, y, z, 1}.
+             * @remark Only the affine 3x4 part of the matrix is used; the projective column is assumed to be {0, 0, 0, 1}.
+            */
+            inline Vector3<T> TransformPoint(const Vector3<T>& point) const {
+                const Vector4<T> v = CombineRows(point.x, point.y, point.z) + vec[3];
+                return { v.x, v.y, v.z };
+            }
 
-                mat.arr[12] = lhs.vec[3].Dot(b.vec[0]);
-                mat.arr[13] = lhs.vec[3].Dot(b.vec[1]);
-                mat.arr[14] = lhs.vec[3].Dot(b.vec[2]);
-                mat.arr[15] = lhs.vec[3].Dot(b.vec[3]);
+            /**
+             * @brief Transforms a direction, treating it as {x, y, z, 0}. Translation is ignored.
+             * @remark Only the affine 3x4 part of the matrix is used.
+            */
+            inline Vector3<T> TransformVector(const Vector3<T>& vector) const {
+                const Vector4<T> v = CombineRows(vector.x, vector.y, vector.z);
+                return { v.x, v.y, v.z };
+            }
 
-                return mat;
+            /**
+             * @brief Transforms a surface normal by the transpose of this matrix.
+             * @remark Call this on the inverse of an object's world matrix, to transform its normals by the inverse-transpose without building it.
+            */
+            inline Vector3<T> TransformNormal(const Vector3<T>& normal) const {
+                return {
+                    static_cast<T>(Vector3<T>::Dot(normal, { arr[0], arr[1], arr[2] })),
+                    static_cast<T>(Vector3<T>::Dot(normal, { arr[4], arr[5], arr[6] })),
+                    static_cast<T>(Vector3<T>::Dot(normal, { arr[8], arr[9], arr[10] })),
+                };
             }
 
             /**
@@ -276,7 +297,142 @@ namespace EDX {
             }
 
 
+            /**
+             * @return true if the projective column is {0, 0, 0, 1}, i.e. the matrix is a 3x3 linear transform followed by a translation. 
+            */
+            bool IsAffine() const {
+                return arr[3] == T(0) && arr[7] == T(0) && arr[11] == T(0) && arr[15] == T(1);
+            }
+
+            /**
+             * @return true if the matrix is affine, and its 3x3 block is orthonormal (a rotation or reflection, with no scaling or shear).
+            */
+            bool IsRigid() const {
+                if (!IsAffine()) {
+                    return false;
+                }
+
+                constexpr double tolerance = 1e-5;
+                for (uint8_t i = 0; i < 3; i++) {
+                    for (uint8_t j = i; j < 3; j++) {
+                        const double expected = (i == j) ? 1.0 : 0.0;
+                        if (std::abs(Vector3<T>::Dot(Row3(i), Row3(j)) - expected) > tolerance) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief Tests whether the matrix is a similarity transform: affine, with a 3x3 block that is a uniform scale of an orthonormal matrix. 
+             * @param scale Receives the uniform scale factor, if the matrix is a similarity. 
+            */
+            bool IsSimilarity(T& scale) const {
+                if (!IsAffine()) {
+                    return false;
+                }
+
+                //Every row must have the same squared length, and be orthogonal to the others; both relative to that length.
+                constexpr double tolerance = 1e-5;
+                const double scaleSquared = Vector3<T>::Dot(Row3(0), Row3(0));
+                if (scaleSquared == 0.0) {
+                    return false;
+                }
+
+                for (uint8_t i = 0; i < 3; i++) {
+                    for (uint8_t j = i; j < 3; j++) {
+                        const double expected = (i == j) ? scaleSquared : 0.0;
+                        if (std::abs(Vector3<T>::Dot(Row3(i), Row3(j)) - expected) > tolerance * scaleSquared) {
+                            return false;
+                        }
+                    }
+                }
+
+                scale = static_cast<T>(std::sqrt(scaleSquared));
+                return true;
+            }
+
+            /**
+             * @brief Computes the inverse of a matrix, using the cheapest method its structure allows.
+             * @param inverseExists Set to false if the matrix is singular, in which case the identity is returned. 
+             * @remark Rigid matrices use InverseRigid, other affine matrices use InverseAffine, and anything else falls back to InverseGeneral. 
+            */
             inline static Matrix4x4 Inverse(const Matrix4x4& matrix, bool& inverseExists) {
+                if (matrix.IsRigid()) {
+                    inverseExists = true;
+                    return InverseRigid(matrix);
+                }
+                if (matrix.IsAffine()) {
+                    return InverseAffine(matrix, inverseExists);
+                }
+                return InverseGeneral(matrix, inverseExists);
+            }
+
+            /**
+             * @brief Inverts a rigid matrix: the 3x3 block is transposed, and the translation is rotated back and negated.
+             * @remark The matrix must satisfy IsRigid(). 
+            */
+            inline static Matrix4x4 InverseRigid(const Matrix4x4& matrix) {
+                const Vector3<T> t = matrix.Row3(3);
+
+                Matrix4x4 inv = Transpose(matrix);
+                inv.arr[3] = inv.arr[7] = inv.arr[11] = T(0);
+                inv.arr[12] = -static_cast<T>(Vector3<T>::Dot(t, matrix.Row3(0)));
+                inv.arr[13] = -static_cast<T>(Vector3<T>::Dot(t, matrix.Row3(1)));
+                inv.arr[14] = -static_cast<T>(Vector3<T>::Dot(t, matrix.Row3(2)));
+                inv.arr[15] = T(1);
+
+                return inv;
+            }
+
+            /**
+             * @brief Inverts an affine matrix, by inverting its 3x3 block from the cross products of its rows, then transforming the negated translation by it. 
+             * @param inverseExists Set to false if the 3x3 block is singular, in which case the identity is returned. 
+             * @remark The matrix must satisfy IsAffine(). 
+            */
+            inline static Matrix4x4 InverseAffine(const Matrix4x4& matrix, bool& inverseExists) {
+                const Vector3<T> r0 = matrix.Row3(0);
+                const Vector3<T> r1 = matrix.Row3(1);
+                const Vector3<T> r2 = matrix.Row3(2);
+
+                //The columns of the inverse are the cross products of pairs of rows, over the determinant. 
+                const Vector3<T> c0 = Vector3<T>::Cross(r1, r2);
+                const Vector3<T> c1 = Vector3<T>::Cross(r2, r0);
+                const Vector3<T> c2 = Vector3<T>::Cross(r0, r1);
+
+                const T det = static_cast<T>(Vector3<T>::Dot(r0, c0));
+                if (det == T(0)) {
+                    inverseExists = false;
+                    return Matrix4x4::Identity();
+                }
+
+                inverseExists = true;
+                const T invDet = T(1) / det;
+
+                Matrix4x4 inv;
+                for (uint8_t i = 0; i < 3; i++) {
+                    inv.arr[(i * 4) + 0] = c0.arr[i] * invDet;
+                    inv.arr[(i * 4) + 1] = c1.arr[i] * invDet;
+                    inv.arr[(i * 4) + 2] = c2.arr[i] * invDet;
+                    inv.arr[(i * 4) + 3] = T(0);
+                }
+
+                const Vector3<T> t = matrix.Row3(3);
+                const Vector3<T> invT = inv.TransformVector(t);
+                inv.arr[12] = -invT.x;
+                inv.arr[13] = -invT.y;
+                inv.arr[14] = -invT.z;
+                inv.arr[15] = T(1);
+
+                return inv;
+            }
+
+            /**
+             * @brief Inverts any 4x4 matrix by cofactor expansion.
+             * @param inverseExists Set to false if the matrix is singular, in which case the identity is returned. 
+            */
+            inline static Matrix4x4 InverseGeneral(const Matrix4x4& matrix, bool& inverseExists) {
 
                 Matrix4x4 inv = {};
                 T det;
@@ -411,6 +567,38 @@ namespace EDX {
                 return inv;
             }
 
+        private:
+            /**
+             * @brief Returns the first three elements of a row. 
+            */
+            inline Vector3<T> Row3(const uint8_t row) const {
+                return { arr[(row * 4) + 0], arr[(row * 4) + 1], arr[(row * 4) + 2] };
+            }
+
+            /**
+             * @brief Computes (x * row0) + (y * row1) + (z * row2) + (w * row3), broadcasting each scalar across a row.
+            */
+            inline Vector4<T> CombineRows(const T x, const T y, const T z, const T w) const {
+                return CombineRows(x, y, z) + (vec[3] * w);
+            }
+
+            /**
+             * @brief Computes (x * row0) + (y * row1) + (z * row2). The affine transforms add the last row themselves, rather than multiplying it by 1 or 0.
+            */
+            inline Vector4<T> CombineRows(const T x, const T y, const T z) const {
+                if constexpr (std::is_same<T, float>::value) {
+                    SIMD::Float4 r = SIMD::Mul(SIMD::Load(vec[0].arr), SIMD::Set1(x));
+                    r = SIMD::MulAdd(SIMD::Load(vec[1].arr), SIMD::Set1(y), r);
+                    r = SIMD::MulAdd(SIMD::Load(vec[2].arr), SIMD::Set1(z), r);
+
+                    Vector4<T> out;
+                    SIMD::Store(out.arr, r);
+                    return out;
+                }
+                else {
+                    return (vec[0] * x) + (vec[1] * y) + (vec[2] * z);
+                }
+            }
         };
 
     }
@@ -0,0 +1,86 @@
+#ifndef __MATHS_SIMD_H
+#define __MATHS_SIMD_H
+/**
+* @file SIMD.h
+* @brief Four-wide float SIMD helpers, with a scalar fallback.
+* @author Ewan Burnett (EwanBurnettSK@outlook.com)
+* @date 2024-10-08
+*/
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDX_SIMD_SSE 1
+#include <immintrin.h>
+#else
+#define EDX_SIMD_SSE 0
+#endif
+
+//FMA is only used when the compiler targets it (e.g. -mfma, or /arch:AVX2 on MSVC); std::fma is emulated in software otherwise.
+#if defined(__FMA__) || defined(__AVX2__)
+#define EDX_SIMD_FMA 1
+#else
+#define EDX_SIMD_FMA 0
+#endif
+
+namespace EDX {
+    namespace Maths {
+        namespace SIMD {
+
+            /**
+             * @brief Computes (a * b) + c, fused into a single rounding when the target supports FMA.
+            */
+            inline float MulAdd(const float a, const float b, const float c) {
+#if EDX_SIMD_FMA
+                return std::fmaf(a, b, c);
+#else
+                return (a * b) + c;
+#endif
+            }
+
+#if EDX_SIMD_SSE
+            typedef __m128 Float4;
+
+            /**
+             * @brief Loads four floats. p must be 16-byte aligned.
+            */
+            inline Float4 Load(const float* p) { return _mm_load_ps(p); }
+            inline void Store(float* p, const Float4 v) { _mm_store_ps(p, v); }
+            inline Float4 Set1(const float s) { return _mm_set1_ps(s); }
+
+            inline Float4 Add(const Float4 a, const Float4 b) { return _mm_add_ps(a, b); }
+            inline Float4 Sub(const Float4 a, const Float4 b) { return _mm_sub_ps(a, b); }
+            inline Float4 Mul(const Float4 a, const Float4 b) { return _mm_mul_ps(a, b); }
+            inline Float4 Div(const Float4 a, const Float4 b) { return _mm_div_ps(a, b); }
+            inline Float4 Negate(const Float4 a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+            inline Float4 MulAdd(const Float4 a, const Float4 b, const Float4 c) {
+#if EDX_SIMD_FMA
+                return _mm_fmadd_ps(a, b, c);
+#else
+                return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+            }
+#else
+            /**
+             * @brief Scalar stand-in for a four-wide register.
+            */
+            struct Float4 {
+                float v[4];
+            };
+
+            inline Float4 Load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+            inline void Store(float* p, const Float4 a) { p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3]; }
+            inline Float4 Set1(const float s) { return { { s, s, s, s } }; }
+
+            inline Float4 Add(const Float4 a, const Float4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+            inline Float4 Sub(const Float4 a, const Float4 b) { return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+            inline Float4 Mul(const Float4 a, const Float4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+            inline Float4 Div(const Float4 a, const Float4 b) { return { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } }; }
+            inline Float4 Negate(const Float4 a) { return { { -a.v[0], -a.v[1], -a.v[2], -a.v[3] } }; }
+            inline Float4 MulAdd(const Float4 a, const Float4 b, const Float4 c) { return Add(Mul(a, b), c); }
+#endif
+        }
+    }
+}
+#endif
@@ -0,0 +1,55 @@
+#ifndef __MATHS_SAMPLING_H
+#define __MATHS_SAMPLING_H
+/**
+* @file Sampling.h
+* @brief Warps uniform random numbers onto directions, for Monte Carlo integration.
+* @author Ewan Burnett (EwanBurnettSK@outlook.com)
+* @date 2024-10-14
+*/
+#include "Utils.h"
+#include "Vector3.h"
+
+namespace EDX {
+    namespace Maths {
+        /**
+         * @brief Builds a tangent and bitangent which form an orthonormal basis with n.
+         * @param n A unit vector.
+         * @remark Branchless construction of Duff et al. (2017), which is stable for any n.
+        */
+        inline void OrthonormalBasis(const Vector3f& n, Vector3f& tangent, Vector3f& bitangent) {
+            const float sign = std::copysign(1.0f, n.z);
+            const float a = -1.0f / (sign + n.z);
+            const float b = n.x * n.y * a;
+            tangent = { 1.0f + (sign * n.x * n.x * a), sign * b, -sign * n.x };
+            bitangent = { b, sign + (n.y * n.y * a), -n.y };
+        }
+
+        /**
+         * @brief Transforms a direction from the local frame, in which the normal is +z, into the frame {tangent, bitangent, normal}.
+        */
+        inline Vector3f FromLocal(const Vector3f& local, const Vector3f& tangent, const Vector3f& bitangent, const Vector3f& normal) {
+            return (tangent * local.x) + (bitangent * local.y) + (normal * local.z);
+        }
+
+        /**
+         * @brief Maps two uniform numbers in [0, 1) to a direction on the +z hemisphere, with pdf 1 / 2PI.
+        */
+        inline Vector3f UniformHemisphere(const float u1, const float u2) {
+            const float z = u1;
+            const float r = sqrtf(std::max(0.0f, 1.0f - (z * z)));
+            const float phi = 2.0f * (float)PI * u2;
+            return { r * cosf(phi), r * sinf(phi), z };
+        }
+
+        /**
+         * @brief Maps two uniform numbers in [0, 1) to a direction on the +z hemisphere, with pdf cos(theta) / PI.
+        */
+        inline Vector3f CosineHemisphere(const float u1, const float u2) {
+            const float r = sqrtf(u1);
+            const float phi = 2.0f * (float)PI * u2;
+            return { r * cosf(phi), r * sinf(phi), sqrtf(std::max(0.0f, 1.0f - u1)) };
+        }
+    }
+}
+
+#endif
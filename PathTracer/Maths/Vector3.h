@@ -10,6 +10,7 @@
 #include <cmath> 
 #include <cstdint>
 #include "Utils.h"
+#include "SIMD.h"
 
 namespace EDX {
     namespace Maths {
@@ -17,7 +18,7 @@ namespace EDX {
          * @brief A Three-Component contiguous Vector
          * @tparam T The type to contain within the vector. This is stored as a union, with {x, y, z}, {u, v, w} and array index members.
          * @note The size of a Vector3 is always sizeof(T) * 3.
-         * @remark Data alignment is implementation defined.
+         * @remark Data alignment is implementation defined. Vector3<float> is deliberately left unpadded, as it's packed into Rays, Triangles and scene data; its Dot, Cross and Normalize use fused multiply-adds instead.
         */
         template<typename T>
         struct Vector3 {
@@ -111,12 +112,15 @@ namespace EDX {
             /**
              * @brief Computes the dot product of two vectors.
             */
-            inline double Dot(const Vector3<T>& other) const { return (double)((x * other.x) + (y * other.y) + (z * other.z)); }
+            inline double Dot(const Vector3<T>& other) const { return Dot(*this, other); }
 
             /**
              * @brief Computes the dot product of two vectors.
             */
-            inline static double Dot(const Vector3<T>& a, const Vector3<T>& b) { return static_cast<double>((a.x * b.x) + (a.y * b.y) + (a.z * b.z)); }
+            inline static double Dot(const Vector3<T>& a, const Vector3<T>& b) {
+                if constexpr (std::is_same<T, float>::value) { return static_cast<double>(SIMD::MulAdd(a.z, b.z, SIMD::MulAdd(a.y, b.y, a.x * b.x))); }
+                else { return static_cast<double>((a.x * b.x) + (a.y * b.y) + (a.z * b.z)); }
+            }
 
             /**
              * @brief Computes the Magnitude of a Vector.
@@ -131,19 +135,19 @@ namespace EDX {
             /**
              * @brief Computes the Squared Length of a Vector.
             */
-            inline double LengthSquared() const { return static_cast<double>((x * x) + (y * y) + (z * z)); }
+            inline double LengthSquared() const { return Dot(*this, *this); }
 
             /**
              * @brief Computes the Magnitude of a Vector.
             */
-            inline static double LengthSquared(const Vector3<T>& vector) { return static_cast<double>((vector.x * vector.x) + (vector.y * vector.y) + (vector.z * vector.z)); }
+            inline static double LengthSquared(const Vector3<T>& vector) { return Dot(vector, vector); }
 
 
             /**
              * @brief Returns the Normalized form of a vector, dividing each component by its length.
              * @return The normalized vector.
             */
-            inline Vector3 Normalize() { return (*this / this->Length()); }
+            inline Vector3 Normalize() const { return Normalize(*this); }
 
             /**
              * @brief Returns the Normalized form of a vector, dividing each component by its length.
@@ -155,15 +159,16 @@ namespace EDX {
             /**
              * @brief Computes the Cross product of two vectors.
             */
-            inline Vector3 Cross(const Vector3<T>& other) {
-                return { (y * other.z) - (z * other.y), (z * other.x) - (x * other.z) , (x * other.y) - (y * other.x) };
-            };
+            inline Vector3 Cross(const Vector3<T>& other) const { return Cross(*this, other); };
 
             /**
              * @brief Computes the Cross product of two vectors.
             */
             inline static Vector3 Cross(const Vector3<T>& a, const Vector3<T>& b) {
-                return { (a.y * b.z) - (a.z * b.y), (a.z * b.x) - (a.x * b.z), (a.x * b.y) - (a.y * b.x) };
+                if constexpr (std::is_same<T, float>::value) {
+                    return { SIMD::MulAdd(a.y, b.z, -(a.z * b.y)), SIMD::MulAdd(a.z, b.x, -(a.x * b.z)), SIMD::MulAdd(a.x, b.y, -(a.y * b.x)) };
+                }
+                else { return { (a.y * b.z) - (a.z * b.y), (a.z * b.x) - (a.x * b.z), (a.x * b.y) - (a.y * b.x) }; }
             };
 
 
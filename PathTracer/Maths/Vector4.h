@@ -10,6 +10,7 @@
 #include <type_traits>
 #include <cmath> 
 #include "Quaternion.h"
+#include "SIMD.h"
 
 namespace EDX {
     namespace Maths {
@@ -17,10 +18,10 @@ namespace EDX {
          * @brief A Four-Component continuous Vector
          * @tparam T The type to contain within the vector. This is stored as a union, with {x, y, z, w} and array index members.
          * @note The size of a Vector4 is always sizeof(T) * 4.
-         * @remark Data alignment is implementation defined.
+         * @remark Vector4<float> is 16-byte aligned, and its arithmetic is performed with SIMD::Float4 operations. Other types use natural alignment.
         */
         template<typename T>
-        struct Vector4 {
+        struct alignas(std::is_same<T, float>::value ? 16 : alignof(T)) Vector4 {
 
             Vector4(Vector3<T> vec, T W = static_cast<T>(0.0)) {
                 x = vec.x;
@@ -46,28 +47,55 @@ namespace EDX {
 
             T& operator[](int idx) { return this->arr[idx]; };
 
-            friend Vector4<T> operator -(Vector4<T> lhs) { return { -lhs.x, -lhs.y, -lhs.z, -lhs.w }; }
+        private:
+            static constexpr bool s_IsSIMD = std::is_same<T, float>::value;
 
-            friend Vector4<T> operator +(Vector4<T> lhs, const Vector4<T>& rhs) { return { lhs.x + rhs.x, lhs.y + rhs.y ,lhs.z + rhs.z, lhs.w + rhs.w }; }
-            friend Vector4<T> operator -(Vector4<T> lhs, const Vector4<T>& rhs) { return { lhs.x - rhs.x, lhs.y - rhs.y ,lhs.z - rhs.z, lhs.w - rhs.w }; }
-            friend Vector4<T> operator *(Vector4<T> lhs, const Vector4<T>& rhs) { return { lhs.x * rhs.x, lhs.y * rhs.y ,lhs.z * rhs.z, lhs.w * rhs.w }; }
-            friend Vector4<T> operator /(Vector4<T> lhs, const Vector4<T>& rhs) { return { lhs.x / rhs.x, lhs.y / rhs.y ,lhs.z / rhs.z, lhs.w / rhs.w }; }
+            //Templated so that the explicit instantiations below don't instantiate them for non-float types.
+            template<typename U = T>
+            inline SIMD::Float4 ToSIMD() const { const U* p = arr; return SIMD::Load(p); }
 
-            friend Vector4<T> operator +(Vector4<T> lhs, const T& rhs) { return { lhs.x + rhs, lhs.y + rhs, lhs.z + rhs, lhs.w + rhs }; }
-            friend Vector4<T> operator -(Vector4<T> lhs, const T& rhs) { return { lhs.x - rhs, lhs.y - rhs, lhs.z - rhs, lhs.w - rhs }; }
-            friend Vector4<T> operator *(Vector4<T> lhs, const T& rhs) { return { lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs }; }
-            friend Vector4<T> operator /(Vector4<T> lhs, const T& rhs) { return { lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs }; }
+            template<typename U = T>
+            inline static Vector4<U> FromSIMD(const SIMD::Float4 v) { Vector4<U> out; SIMD::Store(out.arr, v); return out; }
 
+        public:
 
-            friend Vector4<T> operator +(const T& lhs, Vector4<T> rhs) { return { rhs.x + lhs, rhs.y + lhs, rhs.z + lhs, rhs.w + lhs }; }
-            friend Vector4<T> operator -(const T& lhs, Vector4<T> rhs) { return { rhs.x - lhs, rhs.y - lhs, rhs.z - lhs, rhs.w - lhs }; }
-            friend Vector4<T> operator *(const T& lhs, Vector4<T> rhs) { return { rhs.x * lhs, rhs.y * lhs, rhs.z * lhs, rhs.w * lhs }; }
-            friend Vector4<T> operator /(const T& lhs, Vector4<T> rhs) { return { rhs.x / lhs, rhs.y / lhs, rhs.z / lhs, rhs.w / lhs }; }
+            friend Vector4<T> operator -(const Vector4<T>& lhs) {
+                if constexpr (s_IsSIMD) { return FromSIMD(SIMD::Negate(lhs.ToSIMD())); }
+                else { return { -lhs.x, -lhs.y, -lhs.z, -lhs.w }; }
+            }
+
+            friend Vector4<T> operator +(const Vector4<T>& lhs, const Vector4<T>& rhs) {
+                if constexpr (s_IsSIMD) { return FromSIMD(SIMD::Add(lhs.ToSIMD(), rhs.ToSIMD())); }
+                else { return { lhs.x + rhs.x, lhs.y + rhs.y ,lhs.z + rhs.z, lhs.w + rhs.w }; }
+            }
+            friend Vector4<T> operator -(const Vector4<T>& lhs, const Vector4<T>& rhs) {
+                if constexpr (s_IsSIMD) { return FromSIMD(SIMD::Sub(lhs.ToSIMD(), rhs.ToSIMD())); }
+                else { return { lhs.x - rhs.x, lhs.y - rhs.y ,lhs.z - rhs.z, lhs.w - rhs.w }; }
+            }
+            friend Vector4<T> operator *(const Vector4<T>& lhs, const Vector4<T>& rhs) {
+                if constexpr (s_IsSIMD) { return FromSIMD(SIMD::Mul(lhs.ToSIMD(), rhs.ToSIMD())); }
+                else { return { lhs.x * rhs.x, lhs.y * rhs.y ,lhs.z * rhs.z, lhs.w * rhs.w }; }
+            }
+            friend Vector4<T> operator /(const Vector4<T>& lhs, const Vector4<T>& rhs) {
+                if constexpr (s_IsSIMD) { return FromSIMD(SIMD::Div(lhs.ToSIMD(), rhs.ToSIMD())); }
+                else { return { lhs.x / rhs.x, lhs.y / rhs.y ,lhs.z / rhs.z, lhs.w / rhs.w }; }
+            }
 
-            inline Vector4& operator +=(const Vector4<T>& rhs) { this->x += rhs.x; this->y += rhs.y; this->z += rhs.z; this->w += rhs.w; return *this; }
-            inline Vector4& operator -=(const Vector4<T>& rhs) { this->x -= rhs.x; this->y -= rhs.y; this->z -= rhs.z; this->w -= rhs.w; return *this; }
-            inline Vector4& operator *=(const Vector4<T>& rhs) { this->x *= rhs.x; this->y *= rhs.y; this->z *= rhs.z; this->w *= rhs.w; return *this; }
-            inline Vector4& operator /=(const Vector4<T>& rhs) { this->x /= rhs.x; this->y /= rhs.y; this->z /= rhs.z; this->w /= rhs.w; return *this; }
+            friend Vector4<T> operator +(const Vector4<T>& lhs, const T& rhs) { return lhs + Vector4<T>(rhs, rhs, rhs, rhs); }
+            friend Vector4<T> operator -(const Vector4<T>& lhs, const T& rhs) { return lhs - Vector4<T>(rhs, rhs, rhs, rhs); }
+            friend Vector4<T> operator *(const Vector4<T>& lhs, const T& rhs) { return lhs * Vector4<T>(rhs, rhs, rhs, rhs); }
+            friend Vector4<T> operator /(const Vector4<T>& lhs, const T& rhs) { return lhs / Vector4<T>(rhs, rhs, rhs, rhs); }
+
+
+            friend Vector4<T> operator +(const T& lhs, const Vector4<T>& rhs) { return rhs + lhs; }
+            friend Vector4<T> operator -(const T& lhs, const Vector4<T>& rhs) { return rhs - lhs; }
+            friend Vector4<T> operator *(const T& lhs, const Vector4<T>& rhs) { return rhs * lhs; }
+            friend Vector4<T> operator /(const T& lhs, const Vector4<T>& rhs) { return rhs / lhs; }
+
+            inline Vector4& operator +=(const Vector4<T>& rhs) { return *this = *this + rhs; }
+            inline Vector4& operator -=(const Vector4<T>& rhs) { return *this = *this - rhs; }
+            inline Vector4& operator *=(const Vector4<T>& rhs) { return *this = *this * rhs; }
+            inline Vector4& operator /=(const Vector4<T>& rhs) { return *this = *this / rhs; }
 
             inline Vector4& operator +=(const T& rhs) { this->x += rhs; this->y += rhs; this->z += rhs; this->w += rhs; return *this; }
             inline Vector4& operator -=(const T& rhs) { this->x -= rhs; this->y -= rhs; this->z -= rhs; this->w -= rhs; return *this; }
@@ -81,12 +109,16 @@ namespace EDX {
             /**
              * @brief Computes the dot product of two vectors.
             */
-            inline double Dot(const Vector4<T>& other) { return ((x * other.x) + (y * other.y) + (z * other.z) + (w * other.w)); }
+            inline double Dot(const Vector4<T>& other) const { return Dot(*this, other); }
 
             /**
              * @brief Computes the dot product of two vectors.
             */
-            inline static double Dot(const Vector4<T>& a, const Vector4<T>& b) { return static_cast<double>((a.x * b.x) + (a.y * b.y) + (a.z * b.z) + (a.w * b.w)); }
+            inline static double Dot(const Vector4<T>& a, const Vector4<T>& b) {
+                //Horizontal SIMD adds are slower than this, and stop the compiler vectorising across the Dots in Matrix4x4's products.
+                if constexpr (s_IsSIMD) { return static_cast<double>(SIMD::MulAdd(a.w, b.w, SIMD::MulAdd(a.z, b.z, SIMD::MulAdd(a.y, b.y, a.x * b.x)))); }
+                else { return static_cast<double>((a.x * b.x) + (a.y * b.y) + (a.z * b.z) + (a.w * b.w)); }
+            }
 
             /**
              * @brief Computes the Magnitude of a Vector.
@@ -101,25 +133,28 @@ namespace EDX {
             /**
              * @brief Computes the Squared Length of a Vector.
             */
-            inline double LengthSquared() const { return static_cast<double>((x * x) + (y * y) + (z * z) + (w * w)); }
+            inline double LengthSquared() const { return Dot(*this, *this); }
 
             /**
              * @brief Computes the Magnitude of a Vector.
             */
-            inline static double LengthSquared(const Vector4<T>& vector) { return static_cast<double>((vector.x * vector.x) + (vector.y * vector.y) + (vector.z * vector.z) + (vector.w * vector.w)); }
+            inline static double LengthSquared(const Vector4<T>& vector) { return Dot(vector, vector); }
 
             /**
              * @brief Returns the Normalized form of a vector, dividing each component by its length.
              * @return The normalized vector.
             */
-            inline Vector4 Normalize() { return (*this / this->Length()); }
+            inline Vector4 Normalize() const { return Normalize(*this); }
 
 
             /**
              * @brief Returns the Normalized form of a vector, dividing each component by its length.
              * @return The normalized vector.
             */
-            inline static Vector4 Normalize(const Vector4<T> vector) { return (vector / Length(vector)); }
+            inline static Vector4 Normalize(const Vector4<T>& vector) {
+                if constexpr (s_IsSIMD) { return vector * (1.0f / sqrtf(static_cast<float>(LengthSquared(vector)))); }
+                else { return (vector / Length(vector)); }
+            }
 
             /**
              * @brief Sets each component of this Vector to a value.
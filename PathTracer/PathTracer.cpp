@@ -0,0 +1,345 @@
+#include "PathTracer.h"
+#include "Maths/Sampling.h"
+#include "Sampler.h"
+#include "Denoiser.h"
+
+constexpr float g_PathBias = 0.0001f;       //Offset along the normal for rays leaving a surface, to prevent self-intersection. 
+constexpr float g_ShadowEpsilon = 0.001f;   //Shadow rays towards area lights stop this fraction short, so they don't hit the light itself. 
+constexpr uint32_t g_MaxPathDepth = 256;    //Hard limit on bounces when paths are ended by Russian roulette. 
+constexpr uint32_t g_RouletteDepth = 2;     //Paths always survive their first bounces, where ending them would add the most noise. 
+
+//Sampler dimensions. Each random decision has a fixed dimension, given by its bounce, so a path's random numbers depend only on its pixel, sample and bounce. 
+constexpr uint32_t g_CameraDimension = 0;       //Position within the pixel. 
+constexpr uint32_t g_BounceDimension = 1;       //First dimension of the first bounce. 
+constexpr uint32_t g_LobeDimension = 0;         //Offsets within each bounce's dimensions. 
+constexpr uint32_t g_DirectionDimension = 1;
+constexpr uint32_t g_RouletteDimension = 2;
+constexpr uint32_t g_LightDimension = 3;        //Choice of lights, when they're sampled rather than all shaded. 
+constexpr uint32_t g_AreaLightDimension = 4;    //Choice of area light. 
+constexpr uint32_t g_AreaPointDimension = 5;    //Point on the chosen area light. 
+constexpr uint32_t g_DimensionsPerBounce = 6;
+
+//Light colours are scaled by PI, so a light's direct contribution to a diffuse surface matches the Whitted integrator's. 
+constexpr float g_LightScale = (float)EDX::Maths::PI;
+
+namespace {
+    /**
+     * @brief A path queued for its next bounce.
+    */
+    struct PendingPath {
+        EDX::Ray ray;
+        EDX::Colour throughput;    //Product of each bounce's BRDF * cos / pdf along this path. 
+        uint32_t pixel;            //Index of the pixel this path contributes to, within its block. 
+        uint32_t imagePixel;       //Index of the same pixel within the image, which seeds the path's samples. 
+        float pdf;                 //Probability density of the bounce which chose the ray's direction, or 0 for camera rays. 
+    };
+
+    /**
+     * @brief A light sample, which contributes to its pixel if its shadow ray is unoccluded.
+    */
+    struct ShadowSample {
+        EDX::Colour contribution;
+        uint32_t pixel;
+    };
+
+    inline float MaxComponent(const EDX::Colour& c) {
+        return std::max(c.r, std::max(c.g, c.b));
+    }
+
+    /**
+     * @brief Weights one of two sampling strategies by Veach's power heuristic, given each strategy's pdf for the same sample.
+    */
+    inline float PowerHeuristic(const float pdf, const float otherPdf) {
+        const float p2 = pdf * pdf;
+        const float q2 = otherPdf * otherPdf;
+        return p2 + q2 > 0.0f ? p2 / (p2 + q2) : 0.0f;
+    }
+
+    /**
+     * @brief Returns the probability density of SampleBounce() choosing wi, with respect to solid angle.
+    */
+    float BouncePdf(const EDX::BlinnPhong& m, const EDX::EImportanceSampling mode, const EDX::Maths::Vector3f& n, const EDX::Maths::Vector3f& wo, const EDX::Maths::Vector3f& wi) {
+        const float n_dot_wi = static_cast<float>(EDX::Maths::Vector3f::Dot(n, wi));
+        if (n_dot_wi <= 0.0f) {
+            return 0.0f;
+        }
+
+        switch (mode) {
+        case EDX::EImportanceSampling::BRDF:
+            return m.Pdf(n, wo, wi);
+        case EDX::EImportanceSampling::Cosine:
+            return n_dot_wi / (float)EDX::Maths::PI;
+        default:
+            return 1.0f / (2.0f * (float)EDX::Maths::PI);
+        }
+    }
+
+    /**
+     * @brief Chooses a path's next direction according to the scene's importance sampling mode.
+     * @param u Uniform samples in [0, 1); u[0] selects the lobe, and u[1] and u[2] the direction. 
+     * @param pdf Receives the direction's probability density, with respect to solid angle.
+     * @return false if no direction above the surface was chosen.
+    */
+    bool SampleBounce(const EDX::BlinnPhong& m, const EDX::EImportanceSampling mode, const EDX::Maths::Vector3f& n, const EDX::Maths::Vector3f& wo, const float u[3], EDX::Maths::Vector3f& wi, float& pdf) {
+        if (mode == EDX::EImportanceSampling::BRDF) {
+            if (!m.Sample(n, wo, u, wi)) {
+                return false;
+            }
+            pdf = m.Pdf(n, wo, wi);
+            return pdf > 0.0f;
+        }
+
+        EDX::Maths::Vector3f tangent, bitangent;
+        EDX::Maths::OrthonormalBasis(n, tangent, bitangent);
+
+        if (mode == EDX::EImportanceSampling::Cosine) {
+            wi = EDX::Maths::FromLocal(EDX::Maths::CosineHemisphere(u[1], u[2]), tangent, bitangent, n);
+            pdf = static_cast<float>(EDX::Maths::Vector3f::Dot(n, wi)) / (float)EDX::Maths::PI;
+        }
+        else {
+            wi = EDX::Maths::FromLocal(EDX::Maths::UniformHemisphere(u[1], u[2]), tangent, bitangent, n);
+            pdf = 1.0f / (2.0f * (float)EDX::Maths::PI);
+        }
+        return pdf > 0.0f;
+    }
+}
+
+
+uint32_t EDX::PathTracer::RenderBlock(const Maths::Vector4i block, const uint32_t sample, RenderData& renderData, Film& film)
+{
+    const uint32_t width = block.y - block.x;
+    const uint32_t height = block.w - block.z;
+
+    //Radiance carried back along each pixel's path. 
+    std::vector<EDX::Colour> pixels(width * height, { 0.0f, 0.0f, 0.0f, 0.0f });
+
+    const Sampler& sampler = *renderData.pSampler;
+
+    std::vector<PendingPath> queue;
+    std::vector<PendingPath> next;
+    std::vector<Ray> rays;
+    std::vector<RayHit> hits;
+
+    std::vector<Ray> shadowRays;
+    std::vector<float> shadowDistances;
+    std::vector<ShadowSample> shadowSamples;
+    std::vector<uint8_t> occluded;
+
+    //What each pixel's camera ray hit, to guide the denoiser. 
+    std::vector<FilmFeatures> features(renderData.denoise ? width * height : 0);
+
+    //Pixels which have converged are skipped, when sampling adaptively. 
+    std::vector<uint8_t> active(width * height, 0);
+    uint64_t samples = 0;
+
+    queue.reserve(width * height);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            if (film.IsConverged(block.x + x, block.z + y)) {
+                continue;
+            }
+            active[(y * width) + x] = 1;
+            samples++;
+
+            const uint32_t imagePixel = ((block.z + y) * renderData.dimensions.x) + (block.x + x);
+
+            //Jitter each sample within its pixel. 
+            const Maths::Vector2f jitter = sampler.Get2D(imagePixel, sample, g_CameraDimension);
+            const float px = (float)(block.x + x) + jitter.x;
+            const float py = (float)(block.z + y) + jitter.y;
+            queue.push_back({ renderData.camera.GenRay(px, py), { 1.0f, 1.0f, 1.0f, 1.0f }, (y * width) + x, imagePixel, 0.0f });
+        }
+    }
+
+    for (uint32_t depth = 0; !queue.empty(); depth++) {
+        next.clear();
+        shadowRays.clear();
+        shadowDistances.clear();
+        shadowSamples.clear();
+
+        rays.resize(queue.size());
+        hits.resize(queue.size());
+        for (uint64_t i = 0; i < queue.size(); i++) {
+            rays[i] = queue[i].ray;
+        }
+
+        renderData.scene.TraceRays(rays, hits);
+
+        for (uint64_t i = 0; i < queue.size(); i++) {
+            PendingPath& path = queue[i];
+            const RayHit& result = hits[i];
+
+            if (depth == 0 && renderData.denoise) {
+                features[path.pixel] = Denoiser::Features(path.ray, result);
+            }
+
+            if (result.t == Maths::Infinity || !result.pMat) {
+                continue;   //The path escaped the scene. 
+            }
+
+            const BlinnPhong& m = *result.pMat;
+            const Maths::Vector3f wo = -path.ray.Direction();
+
+            //Shade the side of the surface the path arrived from. 
+            Maths::Vector3f n = result.normal;
+            if (Maths::Vector3f::Dot(n, wo) < 0.0) {
+                n = -n;
+            }
+            const Maths::Vector3f origin = result.point + (n * g_PathBias);
+
+            //Area lights are reached both by sampling them and by bounces which hit them; each is weighted by the power heuristic, so the estimate 
+            //favours light sampling for broad lobes and small lights, and the bounce for narrow lobes and large lights. 
+            //Camera rays, and emissive surfaces which aren't sampled as lights, can only be reached by hitting them. 
+            float emissionWeight = 1.0f;
+            if (path.pdf > 0.0f && result.areaLight != NoAreaLight) {
+                emissionWeight = PowerHeuristic(path.pdf, renderData.pAreaLights->Pdf(path.ray.Origin(), result));
+            }
+            pixels[path.pixel] = pixels[path.pixel] + (path.throughput * m.emission * emissionWeight);
+
+            const uint32_t dimension = g_BounceDimension + (depth * g_DimensionsPerBounce);
+
+            //Paths which end here can't reach a light by bouncing, so light sampling takes its full weight. 
+            const bool isLastBounce = renderData.russianRoulette ? (depth + 1 >= g_MaxPathDepth) : (depth >= renderData.maxDepth);
+
+            //Sample a point on one of the scene's area lights. 
+            if (renderData.pAreaLights->Size() > 0) {
+                const Maths::Vector2f point = sampler.Get2D(path.imagePixel, sample, dimension + g_AreaPointDimension);
+                const float u[3] = { sampler.Get1D(path.imagePixel, sample, dimension + g_AreaLightDimension), point.x, point.y };
+
+                AreaLightSample als = {};
+                if (renderData.pAreaLights->Sample(result.point, u, als)) {
+                    const float n_dot_l = static_cast<float>(Maths::Vector3f::Dot(n, als.wi));
+                    if (n_dot_l > 0.0f) {
+                        shadowRays.push_back({ origin, als.wi });
+                        shadowDistances.push_back(als.distance * (1.0f - g_ShadowEpsilon));
+                        const float weight = isLastBounce ? 1.0f : PowerHeuristic(als.pdf, BouncePdf(m, renderData.importanceSampling, n, wo, als.wi));
+                        shadowSamples.push_back({ path.throughput * m.Evaluate(n, wo, als.wi) * als.emission * (n_dot_l * weight / als.pdf), path.pixel });
+                    }
+                }
+            }
+
+            //Next event estimation; point and directional lights can't be hit by chance, so they're sampled directly. 
+            //Each light's contribution is scaled by a weight; 1 when every light is sampled, or 1 / (count * pmf) for lights chosen at random. 
+            auto sampleDirectional = [&](const DirectionalLight& light, const float weight) {
+                const Maths::Vector3f wi = light.GetDirection().Normalize();
+                const float n_dot_l = static_cast<float>(Maths::Vector3f::Dot(n, wi));
+                if (n_dot_l <= 0.0f) {
+                    return;
+                }
+
+                const Colour radiance = light.GetColour() * (g_LightScale * n_dot_l * weight);
+                shadowRays.push_back({ origin, wi });
+                shadowDistances.push_back(Maths::Infinity);
+                shadowSamples.push_back({ path.throughput * m.Evaluate(n, wo, wi) * radiance, path.pixel });
+            };
+
+            auto samplePoint = [&](const PointLight& light, const float weight) {
+                Maths::Vector3f wi = light.GetPosition() - result.point;
+                const float dist = static_cast<float>(wi.Length());
+                wi = wi / dist;
+
+                const float n_dot_l = static_cast<float>(Maths::Vector3f::Dot(n, wi));
+                if (n_dot_l <= 0.0f) {
+                    return;
+                }
+
+                const Maths::Vector3f& att = light.GetAttenuation();
+                const float attenuation = att.x + (att.y * dist) + (att.z * dist * dist);
+
+                const Colour radiance = light.GetColour() * (g_LightScale * n_dot_l * weight / attenuation);
+                shadowRays.push_back({ origin, wi });
+                shadowDistances.push_back(dist);
+                shadowSamples.push_back({ path.throughput * m.Evaluate(n, wo, wi) * radiance, path.pixel });
+            };
+
+            const auto& directionalLights = renderData.scene.DirectionalLights();
+            const auto& pointLights = renderData.scene.PointLights();
+
+            if (renderData.lightSampling == ELightSampling::All) {
+                for (auto& light : directionalLights) {
+                    sampleDirectional(light, 1.0f);
+                }
+                for (auto& light : pointLights) {
+                    samplePoint(light, 1.0f);
+                }
+            }
+            else {
+                //Choose a few lights, stratified across the pixel's samples, so each hit casts a fixed number of shadow rays however many lights there are. 
+                for (uint32_t l = 0; l < renderData.lightSamples; l++) {
+                    const float u = sampler.Get1D(path.imagePixel, (sample * renderData.lightSamples) + l, dimension + g_LightDimension);
+
+                    LightSample ls = {};
+                    if (!renderData.lightSampler.Sample(result.point, n, u, ls)) {
+                        continue;   //This sample chose lights which can't reach the point; the others may still choose ones which can. 
+                    }
+
+                    const float weight = 1.0f / ((float)renderData.lightSamples * ls.pmf);
+                    if (ls.light < directionalLights.size()) {
+                        sampleDirectional(directionalLights[ls.light], weight);
+                    }
+                    else {
+                        samplePoint(pointLights[ls.light - directionalLights.size()], weight);
+                    }
+                }
+            }
+
+            //Continue the path. 
+            if (isLastBounce) {
+                continue;
+            }
+
+            const Maths::Vector2f direction = sampler.Get2D(path.imagePixel, sample, dimension + g_DirectionDimension);
+            const float u[3] = { sampler.Get1D(path.imagePixel, sample, dimension + g_LobeDimension), direction.x, direction.y };
+
+            Maths::Vector3f wi;
+            float pdf = 0.0f;
+            if (!SampleBounce(m, renderData.importanceSampling, n, wo, u, wi, pdf)) {
+                continue;
+            }
+
+            const float n_dot_wi = static_cast<float>(Maths::Vector3f::Dot(n, wi));
+            Colour throughput = path.throughput * m.Evaluate(n, wo, wi) * (n_dot_wi / pdf);
+
+            if (renderData.russianRoulette && depth >= g_RouletteDepth) {
+                //Survive in proportion to the remaining throughput, and reweight survivors to keep the estimate unbiased. 
+                const float survival = std::min(MaxComponent(throughput), 1.0f);
+                if (sampler.Get1D(path.imagePixel, sample, dimension + g_RouletteDimension) >= survival) {
+                    continue;
+                }
+                throughput = throughput / survival;
+            }
+            else if (MaxComponent(throughput) <= 0.0f) {
+                continue;
+            }
+
+            next.push_back({ { origin, wi }, throughput, path.pixel, path.imagePixel, pdf });
+        }
+
+        //Trace every light sample's shadow ray as one batch. 
+        if (!shadowRays.empty()) {
+            occluded.resize(shadowRays.size());
+            renderData.scene.OccludedRays(shadowRays, shadowDistances, occluded);
+
+            for (uint64_t i = 0; i < shadowSamples.size(); i++) {
+                if (!occluded[i]) {
+                    pixels[shadowSamples[i].pixel] = pixels[shadowSamples[i].pixel] + shadowSamples[i].contribution;
+                }
+            }
+        }
+
+        std::swap(queue, next);
+    }
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            if (active[(y * width) + x]) {
+                film.AddSample(block.x + x, block.z + y, pixels[(y * width) + x]);
+                if (renderData.denoise) {
+                    film.AddFeatures(block.x + x, block.z + y, features[(y * width) + x]);
+                }
+            }
+        }
+    }
+
+    return (uint32_t)samples;
+}
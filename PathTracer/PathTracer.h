@@ -0,0 +1,27 @@
+#ifndef __PATHTRACER_H
+#define __PATHTRACER_H
+/**
+ * @file PathTracer.h
+ * @brief Monte Carlo Path Tracing Integrator
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-14
+*/
+#include "RenderData.h"
+#include "Film.h"
+
+namespace EDX {
+
+    class PathTracer {
+    public:
+        /**
+         * @brief Traces one path through each pixel of a block, adding it to the film. Each bounce of the block is traced as a batch.
+         * @param block The block to render - {xmin, xmax, ymin, ymax}
+         * @param sample Index of the sample within each pixel.
+         * @return The number of paths traced; pixels which have converged are skipped, when sampling adaptively.
+         * @remark Each path's random numbers are drawn from the scene's sampler by pixel, sample index and bounce, so images don't depend on thread count or block order.
+        */
+        static uint32_t RenderBlock(const Maths::Vector4i block, const uint32_t sample, RenderData& renderData, Film& film);
+    };
+}
+
+#endif
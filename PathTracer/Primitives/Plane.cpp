@@ -10,24 +10,15 @@ EDX::Plane::Plane(Maths::Vector3f normal, Maths::Vector3f position)
 
 bool EDX::Plane::Intersects(Ray ray, RayHit& hitResult) const
 {
-    bool isInvertable = false;
-    const Maths::Matrix4x4<float> inverseTransform = EDX::Maths::Matrix4x4<float>::Inverse(m_World, isInvertable);
-    if (!isInvertable) {
+    if (!m_IsInvertible) {
         return false;
     }
+    const Maths::Matrix4x4<float>& inverseTransform = m_InverseWorld;
 
     //Apply the Inverse of this primitive's transformation to the ray. 
     {
-        Maths::Vector4f inv_ray_origin = { ray.Origin().x, ray.Origin().y, ray.Origin().z, 1.0f };
-        Maths::Vector4f inv_ray_dir = { ray.Direction().x, ray.Direction().y, ray.Direction().z, 0.0f };
-
-
-        inv_ray_origin = inv_ray_origin * inverseTransform;
-        inv_ray_dir = inv_ray_dir * inverseTransform;
-        Maths::Vector3f d = { inv_ray_dir.x, inv_ray_dir.y, inv_ray_dir.z };
-        d = d.Normalize();
-
-        ray = Ray({ inv_ray_origin.x, inv_ray_origin.y, inv_ray_origin.z }, d);
+        const Maths::Vector3f d = inverseTransform.TransformVector(ray.Direction()).Normalize();
+        ray = Ray(inverseTransform.TransformPoint(ray.Origin()), d);
     }
 
 
@@ -48,23 +39,10 @@ bool EDX::Plane::Intersects(Ray ray, RayHit& hitResult) const
     hitResult.pMat = const_cast<BlinnPhong*>(&m_Material);
 
     //Compute transformed intersection point
-    {
-        const Maths::Vector3f p = ray.At(t);
-        Maths::Vector4f hit_point = { p.x, p.y, p.z, 1.0f };
-        hit_point = hit_point * m_World;
-        hitResult.point = { hit_point.x, hit_point.y, hit_point.z };
-    }
+    hitResult.point = m_World.TransformPoint(ray.At(t));
 
     //Compute transformed intersection normal by applying the inverse-transpose of the world matrix. 
-    {
-        bool isInvertible = false;
-        const Maths::Matrix4x4<float> invTranspose = Maths::Matrix4x4<float>::Transpose(inverseTransform);
-
-        const Maths::Vector3f n = m_Normal;
-        Maths::Vector4f normal = { n.x, n.y, n.z, 0.0f };
-        normal = normal * invTranspose;
-        hitResult.normal = Maths::Vector3f::Normalize({ normal.x, normal.y, normal.z });
-    }
+    hitResult.normal = inverseTransform.TransformNormal(m_Normal).Normalize();
 
 
     return true;
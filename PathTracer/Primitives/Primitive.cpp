@@ -10,9 +10,24 @@ EDX::BlinnPhong* EDX::Primitive::GetMaterial() const
     return const_cast<EDX::BlinnPhong*>(&m_Material);
 }
 
+void EDX::Primitive::SetAreaLight(uint32_t index)
+{
+    m_AreaLight = index;
+}
+
+uint32_t EDX::Primitive::GetAreaLight() const
+{
+    return m_AreaLight;
+}
+
 void EDX::Primitive::SetWorldMatrix(Maths::Matrix4x4<float> world)
 {
     m_World = world;
+    m_IsIdentity = world.IsIdentity();
+    m_InverseWorld = m_IsIdentity ? world : Maths::Matrix4x4<float>::Inverse(world, m_IsInvertible);
+    if (m_IsIdentity) {
+        m_IsInvertible = true;
+    }
 }
 
 EDX::Maths::Matrix4x4<float> EDX::Primitive::GetWorldMatrix() const
@@ -20,6 +35,16 @@ EDX::Maths::Matrix4x4<float> EDX::Primitive::GetWorldMatrix() const
     return m_World;
 }
 
+const EDX::Maths::Matrix4x4<float>& EDX::Primitive::GetInverseWorldMatrix() const
+{
+    return m_InverseWorld;
+}
+
+bool EDX::Primitive::IsIdentityTransform() const
+{
+    return m_IsIdentity;
+}
+
 const EDX::Primitive::EPrimitiveType EDX::Primitive::GetType() const
 {
     return m_Type;
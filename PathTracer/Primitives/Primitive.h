@@ -29,17 +29,48 @@ namespace EDX {
         void SetMaterial(BlinnPhong material);
         BlinnPhong* GetMaterial() const;
 
-        void SetWorldMatrix(Maths::Matrix4x4<float> world);
+        /**
+         * @brief Sets the primitive's index within the scene's area lights, or NoAreaLight if it isn't sampled as one. 
+        */
+        void SetAreaLight(uint32_t index);
+        uint32_t GetAreaLight() const;
+
+        virtual void SetWorldMatrix(Maths::Matrix4x4<float> world);
         Maths::Matrix4x4<float> GetWorldMatrix() const;
 
+        /**
+         * @return The inverse of the world matrix, computed once when it's set. 
+        */
+        const Maths::Matrix4x4<float>& GetInverseWorldMatrix() const;
+
+        /**
+         * @return true if the world matrix is the identity, in which case intersection tests skip transforming rays and hits. 
+        */
+        bool IsIdentityTransform() const;
+
         const EPrimitiveType GetType() const;
 
+        /**
+         * @return The minimum corner of the primitive's exact world-space bounding box. 
+        */
         virtual Maths::Vector3f GetBoundsMin() const = 0;
+
+        /**
+         * @return The maximum corner of the primitive's exact world-space bounding box. 
+        */
         virtual Maths::Vector3f GetBoundsMax() const = 0;
     protected:
         EPrimitiveType m_Type;
         BlinnPhong m_Material;
+        uint32_t m_AreaLight = NoAreaLight;
         Maths::Matrix4x4<float> m_World;
+        Maths::Matrix4x4<float> m_InverseWorld;
+        bool m_IsIdentity = true;
+        bool m_IsInvertible = true;     //Primitives with a singular world matrix are never hit. 
+
+        //World-space bounds, cached by each primitive type whenever its geometry or world matrix changes. 
+        Maths::Vector3f m_BoundsMin;
+        Maths::Vector3f m_BoundsMax;
     };
 }
 #endif
\ No newline at end of file
@@ -6,33 +6,55 @@ EDX::Sphere::Sphere(Maths::Vector3f position, float radius)
     m_Type = EPrimitiveType::SPHERE;
     m_Position = position;
     m_Radius = radius;
+
+    Precompute();
 }
 
-bool EDX::Sphere::Intersects(Ray ray, RayHit& hitResult) const
+void EDX::Sphere::SetWorldMatrix(Maths::Matrix4x4<float> world)
 {
-    return Intersects(ray, m_Position, m_Radius, m_World, hitResult);
+    Primitive::SetWorldMatrix(world);
+    Precompute();
 }
 
-bool EDX::Sphere::Intersects(Ray ray, const Maths::Vector3f position, const float radius, const Maths::Matrix4x4<float>& world, RayHit& hitResult)
+void EDX::Sphere::Precompute()
 {
-    //Apply the Inverse of this primitive's transformation to the ray. 
-    bool isInvertable = false;
-    const Maths::Matrix4x4<float> inverseTransform = EDX::Maths::Matrix4x4<float>::Inverse(world, isInvertable);
-    if (!isInvertable) {
-        return false;
+    float scale = 1.0f;
+    m_IsWorldSphere = m_IsIdentity || m_World.IsSimilarity(scale);
+
+    m_WorldCentre = m_IsIdentity ? m_Position : m_World.TransformPoint(m_Position);
+    m_WorldRadius = m_Radius * scale;
+    m_WorldRadiusSquared = m_WorldRadius * m_WorldRadius;
+
+    //A transformed sphere is an ellipsoid. Its half-extent along each world axis is the radius scaled by the length of that column of the 3x3 block. 
+    Maths::Vector3f extents = { m_WorldRadius, m_WorldRadius, m_WorldRadius };
+    if (!m_IsWorldSphere) {
+        for (int i = 0; i < 3; i++) {
+            const Maths::Vector3f column = { m_World[i], m_World[4 + i], m_World[8 + i] };
+            extents[i] = m_Radius * static_cast<float>(column.Length());
+        }
     }
 
-    {
-        Maths::Vector4f inv_ray_origin = { ray.Origin().x, ray.Origin().y, ray.Origin().z, 1.0f };
-        Maths::Vector4f inv_ray_dir = { ray.Direction().x, ray.Direction().y, ray.Direction().z, 0.0f };
-
-
-        inv_ray_origin = inv_ray_origin * inverseTransform;
-        inv_ray_dir = inv_ray_dir * inverseTransform;
+    m_BoundsMin = m_WorldCentre - extents;
+    m_BoundsMax = m_WorldCentre + extents;
+}
 
-        Maths::Vector3f d = { inv_ray_dir.x, inv_ray_dir.y, inv_ray_dir.z };
+bool EDX::Sphere::Intersects(Ray ray, RayHit& hitResult) const
+{
+    if (m_IsWorldSphere) {
+        return IntersectsWorldSphere(ray, hitResult);
+    }
+    if (!m_IsInvertible) {
+        return false;
+    }
+    return Intersects(ray, m_Position, m_Radius, m_World, m_InverseWorld, hitResult, m_IsIdentity);
+}
 
-        ray = Ray({ inv_ray_origin.x, inv_ray_origin.y, inv_ray_origin.z }, d);
+bool EDX::Sphere::Intersects(Ray ray, const Maths::Vector3f position, const float radius, const Maths::Matrix4x4<float>& world, const Maths::Matrix4x4<float>& inverseWorld, RayHit& hitResult, const bool isIdentity)
+{
+    //Apply the Inverse of this primitive's transformation to the ray. 
+    //Identity transforms leave the ray in world space, so are skipped entirely. 
+    if (!isIdentity) {
+        ray = Ray(inverseWorld.TransformPoint(ray.Origin()), inverseWorld.TransformVector(ray.Direction()));
     }
 
     //Solve the Quadratic to determine if the ray intersects with the sphere.
@@ -60,24 +82,50 @@ bool EDX::Sphere::Intersects(Ray ray, const Maths::Vector3f position, const floa
     hitResult.t = t;
     const Maths::Vector3f p = ray.At(t);
 
-    //Compute transformed intersection point
-    {
-        Maths::Vector4f hit_point = { p.x, p.y, p.z, 1.0f };
-        hit_point = hit_point * world;
-        hitResult.point = { hit_point.x, hit_point.y, hit_point.z };
+    if (isIdentity) {
+        hitResult.point = p;
+        hitResult.normal = (p - position).Normalize();
+        return true;
     }
 
+    //Compute transformed intersection point
+    hitResult.point = world.TransformPoint(p);
+
     //Compute transformed intersection normal by applying the inverse-transpose of the world matrix. 
     {
-        const Maths::Matrix4x4<float> invTranspose = Maths::Matrix4x4<float>::Transpose(inverseTransform);
-
         Maths::Vector3f n = (p - position).Normalize(); // / m_Radius
+        hitResult.normal = inverseWorld.TransformNormal(n).Normalize();
+    }
 
-        Maths::Vector4f normal = { n.x, n.y, n.z, 0.0f };
-        normal = normal * invTranspose;
-        hitResult.normal = Maths::Vector3f::Normalize({ normal.x, normal.y, normal.z });
+    return true;
+}
+
+bool EDX::Sphere::IntersectsWorldSphere(const Ray& ray, RayHit& hitResult) const
+{
+    //Solve |o + td - c|^2 = r^2, using the half-b form of the quadratic. 
+    const Maths::Vector3f toOrigin = ray.Origin() - m_WorldCentre;
+
+    const float a = static_cast<float>(Maths::Vector3f::Dot(ray.Direction(), ray.Direction()));
+    const float halfB = static_cast<float>(Maths::Vector3f::Dot(ray.Direction(), toOrigin));
+    const float c = static_cast<float>(Maths::Vector3f::Dot(toOrigin, toOrigin)) - m_WorldRadiusSquared;
+
+    const float discriminant = (halfB * halfB) - (a * c);
+    if (discriminant < 0.0f) {
+        return false;
     }
 
+    const float root = sqrtf(discriminant);
+    float t = (-halfB - root) / a;
+    if (t < 0.0f) {
+        t = (-halfB + root) / a;
+        if (t < 0.0f) {
+            return false;
+        }
+    }
+
+    hitResult.t = t;
+    hitResult.point = ray.At(t);
+    hitResult.normal = (hitResult.point - m_WorldCentre).Normalize();
     return true;
 }
 
@@ -89,6 +137,7 @@ EDX::Maths::Vector3f EDX::Sphere::GetPosition() const
 void EDX::Sphere::SetPosition(Maths::Vector3f position)
 {
     m_Position = position;
+    Precompute();
 }
 
 float EDX::Sphere::GetRadius() const
@@ -99,30 +148,30 @@ float EDX::Sphere::GetRadius() const
 void EDX::Sphere::SetRadius(float radius)
 {
     m_Radius = radius;
+    Precompute();
 }
 
 EDX::Maths::Vector3f EDX::Sphere::GetBoundsMin() const
 {
-    EDX::Maths::Vector3f min = {};
-
-    min.x = m_Position.x - m_Radius;
-    min.y = m_Position.y - m_Radius;
-    min.z = m_Position.z - m_Radius;
-
-    EDX::Maths::Vector4f transformed = EDX::Maths::Vector4f({ min.x, min.y, min.z, 1.0f }) * m_World;
-
-    return { transformed.x, transformed.y, transformed.z };
+    return m_BoundsMin;
 }
 
 EDX::Maths::Vector3f EDX::Sphere::GetBoundsMax() const
 {
-    EDX::Maths::Vector3f max = {};
+    return m_BoundsMax;
+}
 
-    max.x = m_Position.x + m_Radius;
-    max.y = m_Position.y + m_Radius;
-    max.z = m_Position.z + m_Radius;
+bool EDX::Sphere::IsWorldSphere() const
+{
+    return m_IsWorldSphere;
+}
 
-    auto transformed = EDX::Maths::Vector4f({ max.x, max.y, max.z, 1.0f }) * m_World;
+EDX::Maths::Vector3f EDX::Sphere::GetWorldCentre() const
+{
+    return m_WorldCentre;
+}
 
-    return { transformed.x, transformed.y, transformed.z };
+float EDX::Sphere::GetWorldRadius() const
+{
+    return m_WorldRadius;
 }
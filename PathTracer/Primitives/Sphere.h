@@ -14,7 +14,9 @@ namespace EDX {
         Sphere(Maths::Vector3f position, float radius);
 
         bool Intersects(Ray ray, RayHit& hitResult) const override;
-        static bool Intersects(Ray ray, const Maths::Vector3f position, const float radius, const Maths::Matrix4x4<float>& world, RayHit& hitResult);
+
+        void SetWorldMatrix(Maths::Matrix4x4<float> world) override;
+        static bool Intersects(Ray ray, const Maths::Vector3f position, const float radius, const Maths::Matrix4x4<float>& world, const Maths::Matrix4x4<float>& inverseWorld, RayHit& hitResult, const bool isIdentity = false);
 
         Maths::Vector3f GetPosition() const;
         void SetPosition(Maths::Vector3f position);
@@ -25,9 +27,32 @@ namespace EDX {
         Maths::Vector3f GetBoundsMin() const override;
         Maths::Vector3f GetBoundsMax() const override;
 
+        /**
+         * @return true if the world matrix keeps the sphere a sphere (rather than an ellipsoid), so its world-space centre and radius describe it exactly. 
+        */
+        bool IsWorldSphere() const;
+        Maths::Vector3f GetWorldCentre() const;
+        float GetWorldRadius() const;
+
     private:
+        /**
+         * @brief Detects world matrices that keep the sphere a sphere, and precomputes its world-space centre and radius. 
+        */
+        void Precompute();
+
+        /**
+         * @brief Intersects a ray with the sphere directly in world space. Only valid if m_IsWorldSphere is set. 
+        */
+        bool IntersectsWorldSphere(const Ray& ray, RayHit& hitResult) const;
+
         Maths::Vector3f m_Position;
         float m_Radius;
+
+        //Identity, rigid and uniformly scaled spheres are intersected in world space, without transforming the ray. Anisotropic scales keep the matrix path. 
+        bool m_IsWorldSphere;
+        Maths::Vector3f m_WorldCentre;
+        float m_WorldRadius;
+        float m_WorldRadiusSquared;
     };
 }
 
@@ -8,41 +8,160 @@ EDX::Triangle::Triangle(Maths::Vector3f pointA, Maths::Vector3f pointB, Maths::V
     m_PointB = pointB;
     m_PointC = pointC;
 
-    //m_Normal = EDX::Maths::Vector3f::Cross((m_PointB - m_PointA), (m_PointC - m_PointA)).Normalize();
+    Precompute();
 }
 
+void EDX::Triangle::SetWorldMatrix(Maths::Matrix4x4<float> world)
+{
+    Primitive::SetWorldMatrix(world);
+    Precompute();
+}
+
+void EDX::Triangle::Precompute()
+{
+    Maths::Vector3f a = m_PointA;
+    Maths::Vector3f b = m_PointB;
+    Maths::Vector3f c = m_PointC;
+
+    if (!m_IsIdentity) {
+        a = m_World.TransformPoint(a);
+        b = m_World.TransformPoint(b);
+        c = m_World.TransformPoint(c);
+
+        //Mirroring transforms flip the winding order; swap two points so the same face is culled as in object space.
+        const Maths::Vector3f x = { m_World[0], m_World[1], m_World[2] };
+        const Maths::Vector3f y = { m_World[4], m_World[5], m_World[6] };
+        const Maths::Vector3f z = { m_World[8], m_World[9], m_World[10] };
+        if (Maths::Vector3f::Dot(x, Maths::Vector3f::Cross(y, z)) < 0.0) {
+            std::swap(b, c);
+        }
+    }
+
+    //The bounds of the transformed points are exact, whatever the transform. 
+    m_BoundsMin = { std::min(a.x, std::min(b.x, c.x)), std::min(a.y, std::min(b.y, c.y)), std::min(a.z, std::min(b.z, c.z)) };
+    m_BoundsMax = { std::max(a.x, std::max(b.x, c.x)), std::max(a.y, std::max(b.y, c.y)), std::max(a.z, std::max(b.z, c.z)) };
+
+    m_Origin = a;
+    m_Edge1 = b - a;
+    m_Edge2 = c - a;
+    m_GeometricNormal = Maths::Vector3f::Cross(m_Edge1, m_Edge2);
+
+    m_IsTranslation = !m_IsIdentity && m_World.IsTranslation();
+    m_InverseTranslation = { m_InverseWorld[12], m_InverseWorld[13], m_InverseWorld[14] };
+
+    //The object-space edges, and the hit normal, are computed exactly as the per-test code used to, so hits are unchanged. 
+    m_ObjectEdge1 = m_PointB - m_PointA;
+    m_ObjectEdge2 = m_PointC - m_PointA;
+    const Maths::Vector3f n = Maths::Vector3f::Cross(m_ObjectEdge1, m_ObjectEdge2);
+    if (n.LengthSquared() > 0.0) {
+        const Maths::Vector3f objectNormal = n.Normalize();
+        m_Normal = Maths::Vector3f::Normalize(m_IsIdentity ? objectNormal : m_InverseWorld.TransformNormal(objectNormal));
+    }
+    else {
+        m_Normal = {};
+    }
+#if ENABLE_WATERTIGHT_TRIANGLES
+    m_VertexB = b;
+    m_VertexC = c;
+#endif
+}
+
+#if ENABLE_WATERTIGHT_TRIANGLES
 bool EDX::Triangle::Intersects(Ray ray, RayHit& hitResult) const
 {
-    //Apply the Inverse of this primitive's transformation to the ray. 
-    //TODO: compute this externally to the intersection test, to allow for simple instancing. 
-    bool isInvertable = false;
-    const Maths::Matrix4x4<float> inverseTransform = EDX::Maths::Matrix4x4<float>::Inverse(m_World, isInvertable);
-    if (!isInvertable) {
+    //Compute intersection using the Watertight algorithm (Woop, Benthin & Wald 2013).
+    //Vertices are translated to the ray origin and sheared so the ray runs along +z (see RayShear), then tested with 2D edge functions. 
+    //Edges shared between triangles produce edge functions of exactly opposite sign, so rays can't slip between them. 
+    const RayShear& shear = ray.Shear();
+    const int kx = shear.kx;
+    const int ky = shear.ky;
+    const int kz = shear.kz;
+    const float sx = shear.sx;
+    const float sy = shear.sy;
+    const float sz = shear.sz;
+
+    const Maths::Vector3f a = m_Origin - ray.Origin();
+    const Maths::Vector3f b = m_VertexB - ray.Origin();
+    const Maths::Vector3f c = m_VertexC - ray.Origin();
+
+    const float ax = a.arr[kx] - (sx * a.arr[kz]);
+    const float ay = a.arr[ky] - (sy * a.arr[kz]);
+    const float bx = b.arr[kx] - (sx * b.arr[kz]);
+    const float by = b.arr[ky] - (sy * b.arr[kz]);
+    const float cx = c.arr[kx] - (sx * c.arr[kz]);
+    const float cy = c.arr[ky] - (sy * c.arr[kz]);
+
+    //Negative edge functions are outside the triangle, or it's back-facing. Only the sign of an exactly zero result is ambiguous. 
+    float u = (cx * by) - (cy * bx);
+    if (u < 0.0f) {
+        return false;
+    }
+    float v = (ax * cy) - (ay * cx);
+    if (v < 0.0f) {
+        return false;
+    }
+    float w = (bx * ay) - (by * ax);
+    if (w < 0.0f) {
+        return false;
+    }
+
+    //Exactly zero edge functions are recomputed in double, to resolve hits on edges and vertices consistently. 
+    if (u == 0.0f || v == 0.0f || w == 0.0f) {
+        u = static_cast<float>((static_cast<double>(cx) * by) - (static_cast<double>(cy) * bx));
+        v = static_cast<float>((static_cast<double>(ax) * cy) - (static_cast<double>(ay) * cx));
+        w = static_cast<float>((static_cast<double>(bx) * ay) - (static_cast<double>(by) * ax));
+
+        if (u < 0.0f || v < 0.0f || w < 0.0f) {
+            return false;
+        }
+    }
+
+    const float det = u + v + w;
+    if (det == 0.0f) {
+        return false;   //Ray is parallel to the triangle
+    }
+
+    const float az = sz * a.arr[kz];
+    const float bz = sz * b.arr[kz];
+    const float cz = sz * c.arr[kz];
+    const float scaledT = (u * az) + (v * bz) + (w * cz);
+    if (scaledT < 0.0f) {
         return false;
     }
 
-    {
-        Maths::Vector4f inv_ray_origin = { ray.Origin().x, ray.Origin().y, ray.Origin().z, 1.0f };
-        Maths::Vector4f inv_ray_dir = { ray.Direction().x, ray.Direction().y, ray.Direction().z, 0.0f };
+    const float t = scaledT / det;
 
+    hitResult.t = t;
+    hitResult.pMat = const_cast<BlinnPhong*>(&m_Material);
+    hitResult.point = ray.At(t);
+    hitResult.normal = m_Normal;
 
-        inv_ray_origin = inv_ray_origin * inverseTransform;
-        inv_ray_dir = inv_ray_dir * inverseTransform;
-        Maths::Vector3f d = { inv_ray_dir.x, inv_ray_dir.y, inv_ray_dir.z };
-        //d = d.Normalize();
+    return true;
+}
+#else
+bool EDX::Triangle::Intersects(Ray ray, RayHit& hitResult) const
+{
+    if (!m_IsInvertible) {
+        return false;
+    }
 
-        ray = Ray({ inv_ray_origin.x, inv_ray_origin.y, inv_ray_origin.z }, d);
+    //Intersect in object space, so the back-face and parallel tests see the same determinant whatever the transform. 
+    //Translations only offset the origin; this gives the same result as transforming by the full matrix. 
+    if (m_IsTranslation) {
+        ray = Ray(ray.Origin() + m_InverseTranslation, ray.Direction());
+    }
+    else if (!m_IsIdentity) {
+        ray = Ray(m_InverseWorld.TransformPoint(ray.Origin()), m_InverseWorld.TransformVector(ray.Direction()));
     }
 
-    
-    //Compute intersection using the Mller-Trumbore Algorithm
+    //Compute intersection using the Moller-Trumbore Algorithm
 
-    Maths::Vector3f e1 = (m_PointB - m_PointA);
-    Maths::Vector3f e2 = (m_PointC - m_PointA);
+    const Maths::Vector3f& e1 = m_ObjectEdge1;
+    const Maths::Vector3f& e2 = m_ObjectEdge2;
 
-    Maths::Vector3f r_x_e2 = Maths::Vector3f::Cross(ray.Direction(), e2);
+    const Maths::Vector3f r_x_e2 = Maths::Vector3f::Cross(ray.Direction(), e2);
 
-    float det = Maths::Vector3f::Dot(e1, r_x_e2);
+    const float det = static_cast<float>(Maths::Vector3f::Dot(e1, r_x_e2));
 
     if (det < 0.0f) {
         return false; //Triangle is back-facing
@@ -51,74 +170,60 @@ bool EDX::Triangle::Intersects(Ray ray, RayHit& hitResult) const
         return false;   //Ray is parallel to the triangle
     }
 
-    float inv_det = 1.0f / det;
+    const float inv_det = 1.0f / det;
 
-    Maths::Vector3f s = ray.Origin() - m_PointA;
-    float u = inv_det * Maths::Vector3f::Dot(s, r_x_e2);
+    const Maths::Vector3f s = ray.Origin() - m_PointA;
+    const float u = inv_det * static_cast<float>(Maths::Vector3f::Dot(s, r_x_e2));
 
     if (u < 0.0f || u > 1.0f) {
         return false;
     }
 
-    Maths::Vector3f s_x_e1 = Maths::Vector3f::Cross(s, e1);
-    float v = inv_det * (Maths::Vector3f::Dot(ray.Direction(), s_x_e1));
+    const Maths::Vector3f s_x_e1 = Maths::Vector3f::Cross(s, e1);
+    const float v = inv_det * static_cast<float>(Maths::Vector3f::Dot(ray.Direction(), s_x_e1));
 
     if ((v < 0.0f) || (u + v > 1.0f)) {
         return false;
     }
 
-    float t = inv_det * Maths::Vector3f::Dot(e2, s_x_e1);
-
+    const float t = inv_det * static_cast<float>(Maths::Vector3f::Dot(e2, s_x_e1));
 
     if (t < 0.0f) {
         return false;
     }
 
     hitResult.t = t;
-    {
-        const Maths::Vector3f p = ray.At(t);
-        Maths::Vector4f hit_point = { p.x, p.y, p.z, 1.0f };
-        hit_point = hit_point * m_World;
-        hitResult.point = { hit_point.x, hit_point.y, hit_point.z };
-    }
-
-    {
-        const Maths::Matrix4x4<float> invTranspose = Maths::Matrix4x4<float>::Transpose(inverseTransform);
-
-        Maths::Vector3f n = Maths::Vector3f::Cross(e1, e2).Normalize();
-        Maths::Vector4f normal = { n.x, n.y, n.z, 0.0f };
-        normal = normal * invTranspose;
-        hitResult.normal = Maths::Vector3f::Normalize({ normal.x, normal.y, normal.z });
-    }
-
     hitResult.pMat = const_cast<BlinnPhong*>(&m_Material);
+    hitResult.point = m_IsIdentity ? ray.At(t) : m_World.TransformPoint(ray.At(t));
+    hitResult.normal = m_Normal;
 
     return true;
-
 }
+#endif
 
 EDX::Maths::Vector3f EDX::Triangle::GetBoundsMin() const
 {
-    Maths::Vector3f min = {};
-
-    min.x = std::min(m_PointA.x, std::min(m_PointB.x, m_PointC.x));
-    min.y = std::min(m_PointA.y, std::min(m_PointB.y, m_PointC.y));
-    min.z = std::min(m_PointA.z, std::min(m_PointB.z, m_PointC.z));
-
-    auto transformed = EDX::Maths::Vector4f({ min.x, min.y, min.z, 1.0f }) * m_World;
-
-    return { transformed.x, transformed.y, transformed.z };
+    return m_BoundsMin;
 }
 
 EDX::Maths::Vector3f EDX::Triangle::GetBoundsMax() const
 {
-    Maths::Vector3f max = {};
+    return m_BoundsMax;
+}
 
-    max.x = std::max(m_PointA.x, std::max(m_PointB.x, m_PointC.x));
-    max.y = std::max(m_PointA.y, std::max(m_PointB.y, m_PointC.y));
-    max.z = std::max(m_PointA.z, std::max(m_PointB.z, m_PointC.z));
+float EDX::Triangle::GetArea() const
+{
+    return static_cast<float>(m_GeometricNormal.Length()) * 0.5f;
+}
 
-    auto transformed = EDX::Maths::Vector4f({ max.x, max.y, max.z, 1.0f }) * m_World;
+EDX::Maths::Vector3f EDX::Triangle::GetNormal() const
+{
+    return m_Normal;
+}
 
-    return { transformed.x, transformed.y, transformed.z };
+void EDX::Triangle::GetWorldEdges(Maths::Vector3f& origin, Maths::Vector3f& edge1, Maths::Vector3f& edge2) const
+{
+    origin = m_Origin;
+    edge1 = m_Edge1;
+    edge2 = m_Edge2;
 }
@@ -11,6 +11,7 @@ namespace EDX {
 
     /**
      * @brief Defines a triangle, with CLOCKWISE winding order. 
+     * @remark The edges and normal are precomputed when the world matrix is set. Intersection tests transform rays by the cached inverse, rather than inverting it per test. 
     */
     class Triangle : public Primitive {
     public: 
@@ -18,16 +19,52 @@ namespace EDX {
 
         bool Intersects(Ray ray, RayHit& hitResult) const override;
 
+        void SetWorldMatrix(Maths::Matrix4x4<float> world) override;
+
 
         Maths::Vector3f GetBoundsMin() const override;
         Maths::Vector3f GetBoundsMax() const override;
 
+        /**
+         * @return The triangle's world-space area. 
+        */
+        float GetArea() const;
+
+        /**
+         * @return The world-space normal of the triangle's front face; the only face rays can hit. 
+        */
+        Maths::Vector3f GetNormal() const;
+
+        /**
+         * @brief Retrieves the triangle's world-space corner A, and its edges to B and C. 
+        */
+        void GetWorldEdges(Maths::Vector3f& origin, Maths::Vector3f& edge1, Maths::Vector3f& edge2) const;
+
     private: 
-        Maths::Vector3f m_PointA; 
+        /**
+         * @brief Precomputes the world-space intersection data from the object-space points and the world matrix. 
+        */
+        void Precompute();
+
+        Maths::Vector3f m_PointA;   //Object-space points. 
         Maths::Vector3f m_PointB; 
         Maths::Vector3f m_PointC; 
+        Maths::Vector3f m_ObjectEdge1;  //B - A, in object space. 
+        Maths::Vector3f m_ObjectEdge2;  //C - A, in object space. 
+        Maths::Vector3f m_InverseTranslation;   //Moves rays into object space, when the world matrix is just a translation. 
+        bool m_IsTranslation = false;
 
-        Maths::Vector3f m_Normal; 
+        //World-space data, for bounds and for sampling the triangle as a light. 
+        Maths::Vector3f m_Origin;   //Point A. 
+        Maths::Vector3f m_Edge1;    //B - A
+        Maths::Vector3f m_Edge2;    //C - A
+        Maths::Vector3f m_GeometricNormal;  //Cross(m_Edge1, m_Edge2), unnormalized. 
+        Maths::Vector3f m_Normal;   //Normalized world-space normal, returned on hits. 
+#if ENABLE_WATERTIGHT_TRIANGLES
+        //The watertight test needs the exact vertices shared with neighbouring triangles, rather than A + edge. 
+        Maths::Vector3f m_VertexB;
+        Maths::Vector3f m_VertexC;
+#endif
 
     };
 }
@@ -7,10 +7,22 @@
  * @date 2024-08-27
 */
 #include "Maths/Vector3.h"
+#include <cmath>
+#include <utility>
 
 namespace EDX {
     using Vec3 = Maths::Vector3f; 
 
+#if ENABLE_WATERTIGHT_TRIANGLES
+    /**
+     * @brief Per-ray constants for the watertight triangle test, which shears space so the ray runs along +z. 
+    */
+    struct RayShear {
+        int kx, ky, kz;     //Axis permutation; kz is the direction's dominant axis. 
+        float sx, sy, sz;   //Shear and scale coefficients. 
+    };
+#endif
+
     class Ray {
     public: 
         Ray(); 
@@ -20,18 +32,42 @@ namespace EDX {
         Vec3 Origin() const; 
         Vec3 Direction() const; 
 
+#if ENABLE_WATERTIGHT_TRIANGLES
+        const RayShear& Shear() const;
+#endif
+
     private:
         Vec3 m_Origin; 
         Vec3 m_Direction; 
+#if ENABLE_WATERTIGHT_TRIANGLES
+        RayShear m_Shear;
+#endif
     };
 
     inline Ray::Ray() {
         m_Origin = {};
         m_Direction = {};
+#if ENABLE_WATERTIGHT_TRIANGLES
+        m_Shear = { 0, 1, 2, 0.0f, 0.0f, 0.0f };
+#endif
     }
 
     inline Ray::Ray(const Vec3& origin, const Vec3& direction) : m_Origin(origin), m_Direction(direction)
     {
+#if ENABLE_WATERTIGHT_TRIANGLES
+        //Permute so that z is the dominant axis, swapping x and y to preserve winding if it's negative. 
+        int kz = 0;
+        if (std::fabs(direction.y) > std::fabs(direction.arr[kz])) { kz = 1; }
+        if (std::fabs(direction.z) > std::fabs(direction.arr[kz])) { kz = 2; }
+        int kx = (kz + 1) % 3;
+        int ky = (kx + 1) % 3;
+        if (direction.arr[kz] < 0.0f) {
+            std::swap(kx, ky);
+        }
+
+        const float sz = 1.0f / direction.arr[kz];
+        m_Shear = { kx, ky, kz, direction.arr[kx] * sz, direction.arr[ky] * sz, sz };
+#endif
     }
 
     inline Vec3 Ray::At(const float t) const {
@@ -45,6 +81,12 @@ namespace EDX {
     inline Vec3 Ray::Direction() const {
         return m_Direction; 
     }
+
+#if ENABLE_WATERTIGHT_TRIANGLES
+    inline const RayShear& Ray::Shear() const {
+        return m_Shear;
+    }
+#endif
 }
 
 #endif
\ No newline at end of file
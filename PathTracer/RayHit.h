@@ -11,12 +11,15 @@
 #include <memory>
 
 namespace EDX {
+    constexpr uint32_t NoAreaLight = 0xFFFFFFFF;
+
     struct RayHit {
         float t = Maths::Infinity;
         Maths::Vector3f point;
         Maths::Vector3f normal;
         
         BlinnPhong* pMat = nullptr;
+        uint32_t areaLight = NoAreaLight;   //Index of the surface within the scene's area lights, if it's sampled as one. 
     };
 }
 
@@ -1,29 +1,41 @@
 #include "RayTracer.h"
+#include "PathTracer.h"
+#include "Denoiser.h"
 #include "Maths.h"
 #include "Utils/Logger.h"
 #include "Utils/Timer.h"
+#include "IO/TextScene.h"
+#include "IO/BinaryScene.h"
 #include <filesystem>
-#include <fstream>
-#include <stack>
-#include <list>
 
 
 constexpr bool g_ShowNormals = false;   //Displays surface normals. 
 constexpr bool g_ShowShadows = false;   //Highlights shadows in Red.
 
+constexpr float g_ReflectionBias = 0.0001f;
+constexpr uint32_t g_CameraDimension = 0;   //Sampler dimension of the position within each pixel. 
+constexpr uint32_t g_LightDimension = 1;    //Sampler dimension of the first hit's light choices; each reflection uses the next. 
+
+namespace {
+    /**
+     * @brief A ray queued for tracing in the next bounce of a block.
+    */
+    struct PendingRay {
+        EDX::Ray ray;
+        EDX::Colour throughput;    //Product of the reflectances along this ray's path. 
+        uint32_t pixel;            //Index of the pixel this ray contributes to, within its block. 
+        uint32_t imagePixel;       //Index of the same pixel within the image, which seeds its samples. 
+    };
+}
+
 
 EDX::Colour EDX::RayTracer::RenderPixel(const uint32_t x, const uint32_t y, EDX::RenderData& renderData)
 {
-    const Maths::Vector4i viewport = {
-        0, renderData.dimensions.x,
-        0, renderData.dimensions.y
-    };
-
-    Ray r = renderData.camera.GenRay(viewport, x, y);
+    Ray r = renderData.camera.GenRay((float)x, (float)y);
 
     EDX::Colour clr = { 0.0f, 0.0f, 0.0f, 1.0f };   //Output Pixel Colour - Black by default. 
 
-    clr = clr + RayColour(r, 0, renderData);
+    clr = clr + RayColour(r, 0, renderData, (y * renderData.dimensions.x) + x);
 
     //Clamp the pixel colour to [0, 1]
     clr.r = EDX::Maths::Clamp(clr.r, 0.0f, 1.0f);
@@ -34,8 +46,110 @@ EDX::Colour EDX::RayTracer::RenderPixel(const uint32_t x, const uint32_t y, EDX:
     return clr;
 }
 
+uint32_t EDX::RayTracer::RenderBlock(const Maths::Vector4i block, const uint32_t sample, RenderData& renderData, Film& film)
+{
+    if (renderData.integrator == EIntegrator::PathTracer) {
+        return PathTracer::RenderBlock(block, sample, renderData, film);
+    }
+
+    const uint32_t width = block.y - block.x;
+    const uint32_t height = block.w - block.z;
+
+    //Output Pixel Colours - Black by default. 
+    std::vector<EDX::Colour> pixels(width * height, { 0.0f, 0.0f, 0.0f, 1.0f });
+
+    //Generate the primary rays for this block. 
+    //A single sample passes through each pixel's corner, as it always has; multiple samples are jittered across the pixel to antialias it. 
+    const bool jitter = renderData.samplesPerPixel > 1;
+
+    //What each pixel's camera ray hit, to guide the denoiser. 
+    std::vector<FilmFeatures> features(renderData.denoise ? width * height : 0);
+
+    //Pixels which have converged are skipped, when sampling adaptively. 
+    std::vector<uint8_t> active(width * height, 0);
+    uint64_t samples = 0;
+
+    std::vector<PendingRay> queue;
+    queue.reserve(width * height);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            if (film.IsConverged(block.x + x, block.z + y)) {
+                continue;
+            }
+            active[(y * width) + x] = 1;
+            samples++;
+
+            const uint32_t imagePixel = ((block.z + y) * renderData.dimensions.x) + (block.x + x);
+
+            float px = (float)(block.x + x);
+            float py = (float)(block.z + y);
+            if (jitter) {
+                const Maths::Vector2f u = renderData.pSampler->Get2D(imagePixel, sample, g_CameraDimension);
+                px += u.x;
+                py += u.y;
+            }
+
+            const Ray r = renderData.camera.GenRay(px, py);
+            queue.push_back({ r, { 1.0f, 1.0f, 1.0f, 1.0f }, (y * width) + x, imagePixel });
+        }
+    }
+
+    std::vector<PendingRay> next;
+    std::vector<Ray> rays;
+    std::vector<RayHit> hits;
+
+    //Trace each bounce as a batch, rather than recursing per-pixel. 
+    for (uint32_t depth = 0; depth <= renderData.maxDepth && !queue.empty(); depth++) {
+        next.clear();
+
+        rays.resize(queue.size());
+        hits.resize(queue.size());
+        for (uint64_t i = 0; i < queue.size(); i++) {
+            rays[i] = queue[i].ray;
+        }
+
+        renderData.scene.TraceRays(rays, hits);
+
+        for (uint64_t i = 0; i < queue.size(); i++) {
+            const PendingRay& pending = queue[i];
+            const RayHit& result = hits[i];
+
+            if (depth == 0 && renderData.denoise) {
+                features[pending.pixel] = Denoiser::Features(pending.ray, result);
+            }
+
+            if (result.t == Maths::Infinity) {
+                continue;   //The ray missed.
+            }
+
+            EDX::Colour reflectance = {};
+            pixels[pending.pixel] = pixels[pending.pixel] + (ShadeHit(pending.ray, result, renderData, reflectance, pending.imagePixel, sample, depth) * pending.throughput);
+
+            if (reflectance.r > 0.0f || reflectance.g > 0.0f || reflectance.b > 0.0f) {
+                const Maths::Vector3f reflectDir = pending.ray.Direction() - 2.0f * result.normal * (float)EDX::Vec3::Dot(pending.ray.Direction(), result.normal);
+                next.push_back({ { result.point + (result.normal * g_ReflectionBias), reflectDir }, pending.throughput * reflectance, pending.pixel, pending.imagePixel });
+            }
+        }
+
+        std::swap(queue, next);
+    }
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            if (active[(y * width) + x]) {
+                film.AddSample(block.x + x, block.z + y, pixels[(y * width) + x]);
+                if (renderData.denoise) {
+                    film.AddFeatures(block.x + x, block.z + y, features[(y * width) + x]);
+                }
+            }
+        }
+    }
+
+    return (uint32_t)samples;
+}
+
 
-EDX::Colour EDX::RayTracer::RayColour(const EDX::Ray ray, uint32_t depth, EDX::RenderData& renderData) {
+EDX::Colour EDX::RayTracer::RayColour(const EDX::Ray ray, uint32_t depth, EDX::RenderData& renderData, const uint32_t pixel) {
 
     //Bounce until Max Depth is reached
     if (depth > renderData.maxDepth) {
@@ -46,8 +160,29 @@ EDX::Colour EDX::RayTracer::RayColour(const EDX::Ray ray, uint32_t depth, EDX::R
 
     EDX::Colour c = { 0.0f, 0.0f, 0.0f, 0.0f };
 
+    //Test Intersection in the scene
+    EDX::RayHit result = {};
+    if (renderData.scene.TraceRay(ray, result))
+    {
+        EDX::Colour reflectance = {};
+        c = ShadeHit(ray, result, renderData, reflectance, pixel, 0, depth - 1);
+
+        if (reflectance.r > 0.0f || reflectance.g > 0.0f || reflectance.b > 0.0f) {
+            const Maths::Vector3f reflectDir = ray.Direction() - 2.0f * result.normal * (float)EDX::Vec3::Dot(ray.Direction(), result.normal);
+            c = c + (RayColour({ result.point + (result.normal * g_ReflectionBias), reflectDir }, depth, renderData, pixel) * reflectance);
+        }
+    }
+
+    return c;
+
+}
+
+EDX::Colour EDX::RayTracer::ShadeHit(const Ray& ray, const RayHit& result, RenderData& renderData, Colour& reflectance, const uint32_t pixel, const uint32_t sample, const uint32_t depth)
+{
+    EDX::Colour c = { 0.0f, 0.0f, 0.0f, 0.0f };
+    reflectance = { 0.0f, 0.0f, 0.0f, 0.0f };
+
     const float shadowBias = 0.0001f;
-    const float reflectionBias = 0.0001f;
 
     auto computeVisibility = [&](const Maths::Vector3f point, const Maths::Vector3f normal, const Maths::Vector3f lightDirection, const float lightDistance) {
 
@@ -55,7 +190,7 @@ EDX::Colour EDX::RayTracer::RayColour(const EDX::Ray ray, uint32_t depth, EDX::R
         {
             EDX::RayHit shadowHit = {};
             //Add a small bias to prevent shadow acne. 
-            bool shadowHitObject = renderData.scene.TraceRay({ point + (normal * shadowBias), lightDirection }, shadowHit, renderData.accelGrid); //Visible if Nothing is hit in the light's direction until the light's position. 
+            bool shadowHitObject = renderData.scene.TraceRay({ point + (normal * shadowBias), lightDirection }, shadowHit); //Visible if Nothing is hit in the light's direction until the light's position. 
 
             //If we didn't hit anything in the light's direction, then the point is visible to the light. 
             if (!shadowHitObject) {
@@ -71,425 +206,336 @@ EDX::Colour EDX::RayTracer::RayColour(const EDX::Ray ray, uint32_t depth, EDX::R
         return isVisible;
     };
 
-    //Test Intersection in the scene
-    EDX::RayHit result = {};
-    if (renderData.scene.TraceRay(ray, result, renderData.accelGrid))
-    {
-        if constexpr (!g_ShowNormals) {
-            //Apply shading based on the Material
-            if (result.pMat) {
-                const EDX::BlinnPhong m = *result.pMat;
-                c = c + m.ambient;
-                c = c + m.emission;
+    if constexpr (g_ShowNormals) {
+        return EDX::Colour(result.normal.x + 1, result.normal.y + 1, result.normal.z + 1, 1.0f) * 0.5f;    //view Normals
+    }
 
-                for (auto& light : renderData.scene.DirectionalLights()) {
-                    const EDX::Maths::Vector3f lightDir = light.GetDirection().Normalize();
+    //Apply shading based on the Material
+    if (!result.pMat) {
+        return c;
+    }
 
-                    EDX::RayHit shadowHit = {};
-                    const bool isVisible = computeVisibility(result.point, result.normal, lightDir, Maths::Infinity);
+    const EDX::BlinnPhong m = *result.pMat;
+    c = c + m.ambient;
+    c = c + m.emission;
 
-                    //Shadow Debugging
-                    if constexpr (g_ShowShadows) {
-                        if (!isVisible) {
-                            c = { 1.0f, 0.0f, 0.0f, 1.0f };
-                            continue;
-                        }
-                    }
+    //Each lit light reflects the scene along the same mirror direction, so accumulate its weight rather than tracing it once per light. 
+    float litCount = 0.0f;
 
-                    const float n_dot_l = EDX::Maths::Vector3f::Dot(result.normal, lightDir);
+    //Each light's contribution is scaled by a weight; 1 when every light is shaded, or 1 / (count * pmf) for lights chosen at random. 
+    auto shadeDirectional = [&](const DirectionalLight& light, const float weight) {
+        const EDX::Maths::Vector3f lightDir = light.GetDirection().Normalize();
 
+        const bool isVisible = computeVisibility(result.point, result.normal, lightDir, Maths::Infinity);
 
-                    const Maths::Vector3f reflectDir = ray.Direction() - 2.0f * result.normal * (float)EDX::Vec3::Dot(ray.Direction(), result.normal);
-                    if (n_dot_l > 0.0f) {
+        //Shadow Debugging
+        if constexpr (g_ShowShadows) {
+            if (!isVisible) {
+                c = { 1.0f, 0.0f, 0.0f, 1.0f };
+                return;
+            }
+        }
 
-                        //If the ray is in shadow,don't reflect it. 
-                        if (isVisible) {
+        const float n_dot_l = EDX::Maths::Vector3f::Dot(result.normal, lightDir);
 
-                            const EDX::Colour& k_Light = light.GetColour();
+        if (n_dot_l > 0.0f) {
 
-                            auto toEye = (ray.Origin() - result.point);
-                            toEye = toEye.Normalize();
-                            const auto h = (lightDir + toEye).Normalize();
+            //If the ray is in shadow,don't reflect it. 
+            if (isVisible) {
 
-                            const float n_dot_h = EDX::Maths::Vector3f::Dot(result.normal, h);
+                const EDX::Colour& k_Light = light.GetColour();
 
-                            c = c + (k_Light * k_Light.a) * ((m.diffuse * n_dot_l) + (m.specular * std::pow(std::max(n_dot_h, 0.0f), m.shininess)));
+                auto toEye = (ray.Origin() - result.point);
+                toEye = toEye.Normalize();
+                const auto h = (lightDir + toEye).Normalize();
 
+                const float n_dot_h = EDX::Maths::Vector3f::Dot(result.normal, h);
 
-                            c = c + (RayColour({ result.point + (result.normal * reflectionBias) , reflectDir }, depth, renderData) * m.specular);
-                        }
-                    }
-                }
+                c = c + ((k_Light * k_Light.a) * ((m.diffuse * n_dot_l) + (m.specular * std::pow(std::max(n_dot_h, 0.0f), m.shininess)))) * weight;
 
-                for (auto& light : renderData.scene.PointLights()) {
-                    EDX::Maths::Vector3f lightDir = (light.GetPosition() - result.point);
-                    const float dist = lightDir.LengthSquared();
-                    lightDir = lightDir.Normalize();
+                litCount += weight;
+            }
+        }
+    };
 
+    auto shadePoint = [&](const PointLight& light, const float weight) {
+        EDX::Maths::Vector3f lightDir = (light.GetPosition() - result.point);
+        const float dist = lightDir.LengthSquared();
+        lightDir = lightDir.Normalize();
 
-                    const bool isVisible = computeVisibility(result.point, result.normal, lightDir, dist);
 
-                    //Shadow Debugging
-                    if constexpr (g_ShowShadows) {
-                        if (!isVisible) {
-                            c = { 1.0f, 0.0f, 0.0f, 1.0f };
-                            continue;
-                        }
-                    }
+        const bool isVisible = computeVisibility(result.point, result.normal, lightDir, dist);
 
+        //Shadow Debugging
+        if constexpr (g_ShowShadows) {
+            if (!isVisible) {
+                c = { 1.0f, 0.0f, 0.0f, 1.0f };
+                return;
+            }
+        }
 
-                    const float n_dot_l = EDX::Maths::Vector3f::Dot(result.normal, lightDir);
 
-                    const Maths::Vector3f reflectDir = ray.Direction() - 2.0f * result.normal * (float)EDX::Vec3::Dot(ray.Direction(), result.normal);
+        const float n_dot_l = EDX::Maths::Vector3f::Dot(result.normal, lightDir);
 
-                    if (n_dot_l > 0.0f) {
+        if (n_dot_l > 0.0f) {
 
-                        //If the ray is in shadow, don't reflect it. 
-                        if (isVisible) {
+            //If the ray is in shadow, don't reflect it. 
+            if (isVisible) {
 
-                            const EDX::Colour& k_Light = light.GetColour();
+                const EDX::Colour& k_Light = light.GetColour();
 
-                            const auto& att = light.GetAttenuation();
-                            float attenuation = att.x + (att.y * dist) + (att.z * dist * dist);
+                const auto& att = light.GetAttenuation();
+                float attenuation = att.x + (att.y * dist) + (att.z * dist * dist);
 
-                            auto toEye = (ray.Origin() - result.point);
-                            toEye = toEye.Normalize();
-                            const auto h = (lightDir + toEye).Normalize();
-                            const float n_dot_h = EDX::Maths::Vector3f::Dot(result.normal, h);
+                auto toEye = (ray.Origin() - result.point);
+                toEye = toEye.Normalize();
+                const auto h = (lightDir + toEye).Normalize();
+                const float n_dot_h = EDX::Maths::Vector3f::Dot(result.normal, h);
 
-                            c = c + ((k_Light * k_Light.a / attenuation) * ((m.diffuse * n_dot_l) + (m.specular * std::pow(std::max(n_dot_h, 0.0f), m.shininess))));
+                c = c + ((k_Light * k_Light.a / attenuation) * ((m.diffuse * n_dot_l) + (m.specular * std::pow(std::max(n_dot_h, 0.0f), m.shininess)))) * weight;
 
-                            c = c + (RayColour({ result.point + (result.normal * reflectionBias), reflectDir }, depth, renderData) * m.specular);
-                        }
-                    }
-                }
+                litCount += weight;
+            }
+        }
+    };
 
+    const auto& directionalLights = renderData.scene.DirectionalLights();
+    const auto& pointLights = renderData.scene.PointLights();
 
-            }
+    if (renderData.lightSampling == ELightSampling::All) {
+        for (auto& light : directionalLights) {
+            shadeDirectional(light, 1.0f);
         }
-        else {
-            c = EDX::Colour(result.normal.x + 1, result.normal.y + 1, result.normal.z + 1, 1.0f) * 0.5f;    //view Normals
+        for (auto& light : pointLights) {
+            shadePoint(light, 1.0f);
         }
     }
+    else {
+        //Choose a few lights at random, stratified across the pixel's samples. 
+        for (uint32_t i = 0; i < renderData.lightSamples; i++) {
+            const float u = renderData.pSampler->Get1D(pixel, (sample * renderData.lightSamples) + i, g_LightDimension + depth);
+
+            LightSample ls = {};
+            if (!renderData.lightSampler.Sample(result.point, result.normal, u, ls)) {
+                continue;   //This sample chose lights which can't reach the point; the others may still choose ones which can. 
+            }
 
-    return c;
+            const float weight = 1.0f / ((float)renderData.lightSamples * ls.pmf);
+            if (ls.light < directionalLights.size()) {
+                shadeDirectional(directionalLights[ls.light], weight);
+            }
+            else {
+                shadePoint(pointLights[ls.light - directionalLights.size()], weight);
+            }
+        }
+    }
+
+    reflectance = m.specular * litCount;
 
+    return c;
 }
 
-bool EDX::RayTracer::LoadSceneFile(const char* filePath, RenderData& renderData)
+bool EDX::RayTracer::LoadSceneFile(const char* filePath, RenderData& renderData, Span<const RenderData* const> loadedScenes)
 {
     EDX::Log::Status("Loading Scene \"%s\".\n", filePath);
     EDX::Timer timer;
     timer.Start();
-    {
 
-        if (!std::filesystem::exists(filePath)) {
-            EDX::Log::Failure("Failed to load Scene \"%s\": File does not Exist!\n", filePath);
-            return false;
-        }
-        const uintmax_t fileSize = std::filesystem::file_size(filePath);
-        if (fileSize == 0) {
-            EDX::Log::Failure("Failed to load Scene \"%s\": File size was Invalid!\n", filePath);
+    uint64_t fileSize = 0;
+    bool isBinary = false;
+    {
+        //Map the whole file; text scenes are parsed in place, and binary scenes are used directly from the mapping. 
+        EDX::IO::MappedFile inScene;
+        if (!OpenSceneFile(filePath, inScene)) {
             return false;
         }
+        fileSize = inScene.Size();
 
-        std::ifstream inScene;
-        inScene.open(filePath);
-        if (!inScene.is_open()) {
-            EDX::Log::Failure("Failed to load Scene \"%s\": Unable to open Scene File!\n", filePath);
-            return false;
+        EDX::IO::SceneDescription description;
+        EDX::IO::SceneView view;
+
+        isBinary = EDX::IO::IsBinaryScene(inScene.Data(), inScene.Size());
+        if (isBinary) {
+            if (!EDX::IO::ReadBinaryScene(inScene.Data(), inScene.Size(), view)) {
+                EDX::Log::Failure("Failed to load Scene \"%s\": Binary Scene was Invalid!\n", filePath);
+                return false;
+            }
+        }
+        else {
+            EDX::IO::ParseTextScene(filePath, inScene.Data(), inScene.Size(), description);
+            view = description.View();
         }
 
-        std::vector<EDX::Maths::Vector3f> vertices;
-        uint64_t currentVtx = 0;
+        BuildScene(view, renderData, loadedScenes);
+    }
 
-        EDX::BlinnPhong material = {};
-        material.ambient = { 0.1f, 0.1f, 0.1f, 1.0f };
+    //Now that both the camera and image size are known, precompute the camera's ray basis. 
+    renderData.camera.SetViewport({ 0, renderData.dimensions.x, 0, renderData.dimensions.y });
 
-        std::stack<EDX::Maths::Matrix4x4<float>> transformStack;
-        std::list<EDX::Maths::Matrix4x4<float>> currentTransforms;
+    timer.Tick();
+    double dtms = timer.DeltaTime();
+    EDX::Log::Success("Finished loading %s scene in %fs (%.2f MB/s).\n", isBinary ? "binary" : "text", dtms, dtms > 0.0 ? ((double)fileSize / (1024.0 * 1024.0)) / dtms : 0.0);
 
-        EDX::Maths::Vector3f attenuation = { 1.0f, 0.0f, 0.0f };
+    return true;
+}
 
-        auto currentTransform = [&]() {
-            EDX::Maths::Matrix4x4<float> acc = {};
-            for (auto t = currentTransforms.rbegin(); t != currentTransforms.rend(); t++) {
-                acc = acc * *t;
-            }
+bool EDX::RayTracer::ConvertSceneFile(const char* filePath, const char* outputPath)
+{
+    EDX::Log::Status("Converting Scene \"%s\" to \"%s\".\n", filePath, outputPath);
 
-            return acc;
-        };
+    EDX::IO::MappedFile inScene;
+    if (!OpenSceneFile(filePath, inScene)) {
+        return false;
+    }
 
+    if (EDX::IO::IsBinaryScene(inScene.Data(), inScene.Size())) {
+        EDX::Log::Failure("Failed to convert Scene \"%s\": Scene is already Binary!\n", filePath);
+        return false;
+    }
 
-        //Parse each line from the file. 
-        for (std::string line; std::getline(inScene, line);) {
-            //Ignore blank lines
-            if (line.size() == 0) {
-                continue;
-            }
-            //Ignore Comments
-            if (line.at(0) == '#') {
-                continue;
-            }
-            if (line.find_first_not_of(" ") >= line.size()) {
-                continue;
-            }
+    EDX::IO::SceneDescription description;
+    EDX::IO::ParseTextScene(filePath, inScene.Data(), inScene.Size(), description);
 
-            //EDX::Log::Debug("%s\n", line.c_str());
-
-            //Split the line into tokens, delimited by a space ' '.
-            std::vector<std::string> tokens;
-            {
-                uint64_t offset = 0;
-                while (offset != std::string::npos) {
-                    offset = line.find(' ');
-                    auto token = line.substr(0, offset);
-                    if (!token.empty()) {
-                        tokens.push_back(token);
-                    }
-                    line.erase(0, offset + 1);
-                }
-            }
+    if (!EDX::IO::WriteBinaryScene(outputPath, description.View())) {
+        return false;
+    }
 
-            //Parse Each Command
-            std::string command = tokens[0];
-            {
-                //The 'size' command specifies a render's size:
-                //size [x] [y]
-                if (command == "size") {
-                    renderData.dimensions.x = static_cast<uint16_t>(std::stoi(tokens[1]));
-                    renderData.dimensions.y = static_cast<uint16_t>(std::stoi(tokens[2]));
-                }
-                //The 'camera' command defines a camera
-                //camera [lookFrom xyz] [lookAt xyz] [up xyz] [FoVDegrees]
-                else if (command == "camera") {
-                    EDX::Maths::Vector3f lookFrom = {};
-                    {
-                        lookFrom.x = std::stof(tokens[1]);
-                        lookFrom.y = std::stof(tokens[2]);
-                        lookFrom.z = std::stof(tokens[3]);
-                    }
-
-                    EDX::Maths::Vector3f lookAt = {};
-                    {
-                        lookAt.x = std::stof(tokens[4]);
-                        lookAt.y = std::stof(tokens[5]);
-                        lookAt.z = std::stof(tokens[6]);
-                    }
-
-                    EDX::Maths::Vector3f up = {};
-                    {
-                        up.x = std::stof(tokens[7]);
-                        up.y = std::stof(tokens[8]);
-                        up.z = std::stof(tokens[9]);
-                    }
-
-                    float fovDegrees = std::stof(tokens[10]);
-
-                    renderData.camera = EDX::Camera(lookFrom, lookAt, up, EDX::Maths::DegToRad(fovDegrees));
-                    //transformStack.push(renderData.camera.GetViewMatrix());
-                }
-                //The 'output' command specifies an output name.
-                //Extensions are stripped, and a timestamp is added during export.
-                //output [file name]
-                else if (command == "output") {
-                    renderData.outputName = tokens[1];
-                }
-                //The 'sphere' command defines a sphere
-                //sphere [position xyz] [radius]
-                else if (command == "sphere") {
-                    EDX::Maths::Vector3f position = {};
-                    {
-                        position.x = std::stof(tokens[1]);
-                        position.y = std::stof(tokens[2]);
-                        position.z = std::stof(tokens[3]);
-                    }
-
-                    float radius = std::stof(tokens[4]);
-                    EDX::Sphere s = { position, radius };
-                    s.SetMaterial(material);
-                    s.SetWorldMatrix(currentTransform());
-                    renderData.scene.Spheres().push_back(s);
-                }
-                //The 'maxverts' command specifies the maximum number of vertices in this scene. 
-                //Used for array sizing. 
-                //maxverts [count] 
-                else if (command == "maxverts") {
-                    const uint64_t max_verts = std::stoi(tokens[1]);
-                    vertices.resize(max_verts);
-                }
-                //The 'vertex' command defines a vertex in the scene. 
-                //Indexed by the 'tri' command to construct triangles. 
-                //vertex [x] [y] [z]
-                else if (command == "vertex") {
-                    EDX::Maths::Vector3f vtx = {};
-                    {
-                        vtx.x = std::stof(tokens[1]);
-                        vtx.y = std::stof(tokens[2]);
-                        vtx.z = std::stof(tokens[3]);
-                    }
-
-                    vertices[currentVtx] = vtx;
-                    currentVtx++;
-                }
-                //The 'tri' command defines a triangle geometry.
-                //Defined by 3 vertices, a, b and c - indexed into the vertices array. 
-                //tri [a] [b] [c]
-                else if (command == "tri") {
-                    uint32_t a = std::stoi(tokens[1]);
-                    uint32_t b = std::stoi(tokens[2]);
-                    uint32_t c = std::stoi(tokens[3]);
-
-                    EDX::Triangle t = { vertices[a], vertices[b], vertices[c] };
-                    t.SetMaterial(material);
-                    t.SetWorldMatrix(currentTransform());
-                    renderData.scene.Triangles().push_back(t);
-                }
-                //The 'directional' command defines a Directional light
-                //Defined by a Direction and a colour. 
-                //direction [dir xyz] [colour rgb]
-                else if (command == "directional") {
-                    EDX::Maths::Vector3f direction = {};
-                    {
-                        direction.x = std::stof(tokens[1]);
-                        direction.y = std::stof(tokens[2]);
-                        direction.z = std::stof(tokens[3]);
-                    }
-
-                    EDX::Colour colour = {};
-                    {
-                        colour.r = std::stof(tokens[4]);
-                        colour.g = std::stof(tokens[5]);
-                        colour.b = std::stof(tokens[6]);
-                        colour.a = 1.0f;
-                    }
-
-                    renderData.scene.DirectionalLights().push_back({ direction, colour });
-                }
-                else if (command == "diffuse") {
-                    EDX::Colour d = {};
-                    {
-                        d.r = std::stof(tokens[1]);
-                        d.g = std::stof(tokens[2]);
-                        d.b = std::stof(tokens[3]);
-                        d.a = 1.0f;
-                    }
-                    material.diffuse = d;
-                }
-                else if (command == "ambient") {
-                    EDX::Colour a = {};
-                    {
-                        a.r = std::stof(tokens[1]);
-                        a.g = std::stof(tokens[2]);
-                        a.b = std::stof(tokens[3]);
-                        a.a = 1.0f;
-                    }
-                    material.ambient = a;
-                }
-                else if (command == "emission") {
-                    EDX::Colour e = {};
-                    {
-                        e.r = std::stof(tokens[1]);
-                        e.g = std::stof(tokens[2]);
-                        e.b = std::stof(tokens[3]);
-                        e.a = 1.0f;
-                    }
-                    material.emission = e;
-                }
-                else if (command == "specular") {
-                    EDX::Colour s = {};
-                    {
-                        s.r = std::stof(tokens[1]);
-                        s.g = std::stof(tokens[2]);
-                        s.b = std::stof(tokens[3]);
-                        s.a = 1.0f;
-                    }
-                    material.specular = s;
-                }
-                else if (command == "shininess") {
-                    material.shininess = std::stof(tokens[1]);
-                }
-                else if (command == "pushTransform") {
-                    transformStack.push(currentTransform());
-                    //currentTransforms.clear();
-                }
-                else if (command == "popTransform") {
-                    currentTransforms.clear();
-                    currentTransforms.push_front(transformStack.top());
-                    transformStack.pop();
-                }
+    EDX::Log::Success("Converted Scene \"%s\": %llu vertices, %llu triangles, %llu spheres.\n", filePath, (unsigned long long)description.vertices.size(), (unsigned long long)description.triangles.size(), (unsigned long long)description.spheres.size());
+    return true;
+}
 
-                else if (command == "translate") {
-                    EDX::Maths::Vector3f t = {
-                        std::stof(tokens[1]),
-                        std::stof(tokens[2]),
-                        std::stof(tokens[3])
-                    };
-                    auto translation = EDX::Maths::Matrix4x4<float>::Translation(t);
-                    currentTransforms.push_back(translation);
-                }
-                else if (command == "rotate") {
-                    const EDX::Maths::Vector3f axis = EDX::Maths::Vector3f::Normalize({
-                        std::stof(tokens[1]),
-                        std::stof(tokens[2]),
-                        std::stof(tokens[3])
-                        });
+bool EDX::RayTracer::OpenSceneFile(const char* filePath, IO::MappedFile& file)
+{
+    if (!std::filesystem::exists(filePath)) {
+        EDX::Log::Failure("Failed to load Scene \"%s\": File does not Exist!\n", filePath);
+        return false;
+    }
+    if (std::filesystem::file_size(filePath) == 0) {
+        EDX::Log::Failure("Failed to load Scene \"%s\": File size was Invalid!\n", filePath);
+        return false;
+    }
+    if (!file.Open(filePath)) {
+        EDX::Log::Failure("Failed to load Scene \"%s\": Unable to open Scene File!\n", filePath);
+        return false;
+    }
 
+    return true;
+}
 
-                    const float angle = EDX::Maths::DegToRad(std::stof(tokens[4]));
+void EDX::RayTracer::BuildScene(const IO::SceneView& view, RenderData& renderData, Span<const RenderData* const> loadedScenes)
+{
+    renderData.dimensions.x = view.width;
+    renderData.dimensions.y = view.height;
+    renderData.maxDepth = view.maxDepth;
+    renderData.integrator = static_cast<EIntegrator>(view.integrator.type);
+    renderData.samplesPerPixel = std::max(view.integrator.samplesPerPixel, 1u);
+    renderData.importanceSampling = static_cast<EImportanceSampling>(view.integrator.importanceSampling);
+    renderData.russianRoulette = view.integrator.russianRoulette != 0;
+    renderData.timeBudget = view.integrator.timeBudget;
+    renderData.noiseThreshold = view.integrator.noiseThreshold;
+    renderData.adaptiveThreshold = view.integrator.adaptiveThreshold;
+    renderData.pSampler = Sampler::Create(static_cast<ESampler>(view.integrator.sampler));
+    renderData.lightSampling = static_cast<ELightSampling>(view.integrator.lightSampling);
+    renderData.lightSamples = std::max(view.integrator.lightSamples, 1u);
+    renderData.denoise = view.integrator.denoise != 0;
+    renderData.outputName = std::string(view.outputName);
+    renderData.geometryHash = view.geometryHash;
+
+    //Scenes which share geometry with an earlier one trace its primitives instead, so they're only ever built once. 
+    renderData.pSharedGeometry = nullptr;
+    for (const RenderData* pLoaded : loadedScenes) {
+        if (!pLoaded->pSharedGeometry && pLoaded->geometryHash == renderData.geometryHash) {
+            renderData.pSharedGeometry = pLoaded;
+            break;
+        }
+    }
 
-                    EDX::Maths::Quaternion q;
-                    q = q.FromAxisAngle(axis, angle);
+    if (view.hasCamera) {
+        const IO::SceneCamera& c = view.camera;
+        Maths::Vector3f lookFrom = { c.lookFrom[0], c.lookFrom[1], c.lookFrom[2] };
+        Maths::Vector3f lookAt = { c.lookAt[0], c.lookAt[1], c.lookAt[2] };
+        Maths::Vector3f up = { c.up[0], c.up[1], c.up[2] };
 
-                    auto m = q.ToMatrix4x4();
-                    currentTransforms.push_back(m);
-                }
-                else if (command == "scale") {
-                    EDX::Maths::Vector3f s = {
-                    std::stof(tokens[1]),
-                    std::stof(tokens[2]),
-                    std::stof(tokens[3])
-                    };
-
-                    currentTransforms.push_back(EDX::Maths::Matrix4x4<float>::Scaling(s));
-                }
-                else if (command == "point") {
-                    EDX::Maths::Vector3f position = {};
-                    {
-                        position.x = std::stof(tokens[1]);
-                        position.y = std::stof(tokens[2]);
-                        position.z = std::stof(tokens[3]);
-                    }
-
-                    EDX::Colour colour = {};
-                    {
-                        colour.r = std::stof(tokens[4]);
-                        colour.g = std::stof(tokens[5]);
-                        colour.b = std::stof(tokens[6]);
-                        colour.a = 1.0f;
-                    }
-
-                    renderData.scene.PointLights().push_back({ position, attenuation, colour });
-                }
-                else if (command == "attenuation") {
-                    attenuation.x = std::stof(tokens[1]);
-                    attenuation.y = std::stof(tokens[2]);
-                    attenuation.z = std::stof(tokens[3]);
-                }
-                else if (command == "maxdepth") {
-                    renderData.maxDepth = std::stof(tokens[1]);
-                }
-                else {
-                    EDX::Log::Warning("Unknown Command \"%s\".\n", command.c_str());
-                }
-            }
+        renderData.camera = EDX::Camera(lookFrom, lookAt, up, Maths::DegToRad(c.fovDegrees));
+    }
+
+    //Expand the material and transform tables once, rather than per primitive. 
+    std::vector<BlinnPhong> materials(view.materials.Size());
+    for (uint64_t i = 0; i < view.materials.Size(); i++) {
+        const IO::SceneMaterial& m = view.materials[i];
+        materials[i].ambient = { m.ambient[0], m.ambient[1], m.ambient[2], m.ambient[3] };
+        materials[i].diffuse = { m.diffuse[0], m.diffuse[1], m.diffuse[2], m.diffuse[3] };
+        materials[i].specular = { m.specular[0], m.specular[1], m.specular[2], m.specular[3] };
+        materials[i].emission = { m.emission[0], m.emission[1], m.emission[2], m.emission[3] };
+        materials[i].shininess = m.shininess;
+    }
+
+    std::vector<Maths::Matrix4x4<float>> transforms(view.transforms.Size());
+    for (uint64_t i = 0; i < view.transforms.Size(); i++) {
+        memcpy(transforms[i].arr, view.transforms[i].m, sizeof(view.transforms[i].m));
+    }
+
+    auto& triangles = renderData.scene.Triangles();
+    auto& spheres = renderData.scene.Spheres();
+    if (!renderData.pSharedGeometry) {
+        triangles.reserve(triangles.size() + view.triangles.Size());
+        for (const IO::SceneTriangle& t : view.triangles) {
+            const float* a = view.vertices[t.indices[0]].position;
+            const float* b = view.vertices[t.indices[1]].position;
+            const float* c = view.vertices[t.indices[2]].position;
+
+            EDX::Triangle tri = { { a[0], a[1], a[2] }, { b[0], b[1], b[2] }, { c[0], c[1], c[2] } };
+            tri.SetMaterial(materials[t.material]);
+            tri.SetWorldMatrix(transforms[t.transform]);
+            triangles.push_back(tri);
         }
 
+        spheres.reserve(spheres.size() + view.spheres.Size());
+        for (const IO::SceneSphere& s : view.spheres) {
+            EDX::Sphere sphere = { { s.centre[0], s.centre[1], s.centre[2] }, s.radius };
+            sphere.SetMaterial(materials[s.material]);
+            sphere.SetWorldMatrix(transforms[s.transform]);
+            spheres.push_back(sphere);
+        }
     }
 
-    timer.Tick();
-    double dtms = timer.DeltaTime();
-    EDX::Log::Success("Finished loading scene in %fs.\n", dtms);
+    for (const IO::SceneDirectionalLight& l : view.directionalLights) {
+        renderData.scene.DirectionalLights().push_back({ { l.direction[0], l.direction[1], l.direction[2] }, { l.colour[0], l.colour[1], l.colour[2], 1.0f } });
+    }
 
-    return true;
+    for (const IO::ScenePointLight& l : view.pointLights) {
+        renderData.scene.PointLights().push_back({ { l.position[0], l.position[1], l.position[2] }, { l.attenuation[0], l.attenuation[1], l.attenuation[2] }, { l.colour[0], l.colour[1], l.colour[2], 1.0f } });
+    }
+
+    if (renderData.lightSampling != ELightSampling::All) {
+        //Point lights' attenuation is weighed at half the extent of the scene's geometry, as a typical distance to the surfaces they light. 
+        Maths::Vector3f boundsMin = { Maths::Infinity, Maths::Infinity, Maths::Infinity };
+        Maths::Vector3f boundsMax = { -Maths::Infinity, -Maths::Infinity, -Maths::Infinity };
+        auto grow = [&](const Maths::Vector3f& min, const Maths::Vector3f& max) {
+            for (int axis = 0; axis < 3; axis++) {
+                boundsMin.arr[axis] = std::min(boundsMin.arr[axis], min.arr[axis]);
+                boundsMax.arr[axis] = std::max(boundsMax.arr[axis], max.arr[axis]);
+            }
+        };
+        const Scene& geometry = renderData.pSharedGeometry ? renderData.pSharedGeometry->scene : renderData.scene;
+        for (const Triangle& t : geometry.Triangles()) {
+            grow(t.GetBoundsMin(), t.GetBoundsMax());
+        }
+        for (const Sphere& s : geometry.Spheres()) {
+            grow(s.GetBoundsMin(), s.GetBoundsMax());
+        }
+        const float sceneRadius = boundsMin.x <= boundsMax.x ? static_cast<float>((boundsMax - boundsMin).Length()) * 0.5f : 1.0f;
+
+        renderData.lightSampler.Build(renderData.lightSampling, renderData.scene.DirectionalLights(), renderData.scene.PointLights(), sceneRadius);
+    }
+
+    //Only the path tracer lights the scene with emissive geometry; the Whitted integrator adds emission as a flat colour. 
+    //They're built regardless, as a path traced scene may share these primitives, and needs them marked as lights. 
+    if (renderData.pSharedGeometry) {
+        renderData.pAreaLights = renderData.pSharedGeometry->pAreaLights;
+    }
+    else {
+        renderData.areaLights.Build(triangles, spheres);
+        renderData.pAreaLights = &renderData.areaLights;
+    }
 }
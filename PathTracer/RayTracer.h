@@ -3,17 +3,53 @@
 
 #include "RenderData.h"
 #include "Image.h"
+#include "Film.h"
 #include "Ray.h"
 #include "Colour.h"
+#include "IO/MappedFile.h"
+#include "IO/SceneDescription.h"
 
 namespace EDX {
 
     class RayTracer {
     public: 
         static Colour RenderPixel(const uint32_t x, const uint32_t y, RenderData& renderData);
-        static bool LoadSceneFile(const char* filePath, RenderData& renderData);
+
+        /**
+         * @brief Renders one sample per pixel of a block into a film, tracing each bounce of the block as a batch.
+         * @param block The block to render - {xmin, xmax, ymin, ymax}
+         * @param sample Index of the sample within each pixel. Samples are jittered within the pixel when the scene takes more than one.
+         * @return The number of samples taken; pixels which have converged are skipped, when sampling adaptively.
+         * @remark Scenes which select the path tracer are rendered by PathTracer::RenderBlock instead.
+        */
+        static uint32_t RenderBlock(const Maths::Vector4i block, const uint32_t sample, RenderData& renderData, Film& film);
+
+        /**
+         * @brief Loads a scene into renderData. Text (.test) and binary scenes are detected automatically.
+         * @param loadedScenes Scenes which are already loaded. If one's geometry matches, it's shared rather than building another copy of its primitives; see RenderData::pSharedGeometry.
+        */
+        static bool LoadSceneFile(const char* filePath, RenderData& renderData, Span<const RenderData* const> loadedScenes = {});
+
+        /**
+         * @brief Converts a text scene file into a binary scene file, which loads without parsing.
+        */
+        static bool ConvertSceneFile(const char* filePath, const char* outputPath);
     private:
-        static Colour RayColour(const Ray ray, uint32_t depth, RenderData& renderData);
+        static bool OpenSceneFile(const char* filePath, IO::MappedFile& file);
+
+        /**
+         * @brief Creates the primitives, lights, camera and settings described by a scene.
+        */
+        static void BuildScene(const IO::SceneView& view, RenderData& renderData, Span<const RenderData* const> loadedScenes);
+
+        static Colour RayColour(const Ray ray, uint32_t depth, RenderData& renderData, const uint32_t pixel);
+
+        /**
+         * @brief Computes the local (emitted + direct) colour at a hit point.
+         * @param reflectance Receives the weight to apply to the colour seen along the mirror reflection direction.
+         * @param pixel, sample, depth Seed the choice of lights, when they're sampled rather than all shaded.
+        */
+        static Colour ShadeHit(const Ray& ray, const RayHit& result, RenderData& renderData, Colour& reflectance, const uint32_t pixel, const uint32_t sample, const uint32_t depth);
         //static Maths::Vector3f OrientRay(const uint32_t x, const uint32_t y, const RenderData& renderData);
 
     };
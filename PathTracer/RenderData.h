@@ -6,8 +6,23 @@
 #include "Camera.h"
 #include "Acceleration/Grid.h"
 #include "Scene.h"
+#include "Sampler.h"
+#include "Lights/LightSampler.h"
+#include "Lights/AreaLights.h"
+#include <memory>
 
 namespace EDX {
+    enum class EIntegrator : uint32_t {
+        RayTracer = 0,      //Whitted-style ray tracing; direct lighting plus mirror reflections.
+        PathTracer,         //Monte Carlo path tracing.
+    };
+
+    enum class EImportanceSampling : uint32_t {
+        Hemisphere = 0,     //Uniform over the hemisphere.
+        Cosine,             //Cosine-weighted.
+        BRDF,               //In proportion to the material's diffuse and specular lobes.
+    };
+
     struct RenderData {
         std::string outputName;
         Maths::Vector2<uint16_t> dimensions;
@@ -15,7 +30,23 @@ namespace EDX {
         EDX::Camera camera;
         Scene scene;
         uint32_t maxDepth = 1;
+        EIntegrator integrator = EIntegrator::RayTracer;
+        uint32_t samplesPerPixel = 1;   //Maximum number of samples taken per pixel. 
+        EImportanceSampling importanceSampling = EImportanceSampling::BRDF;
+        bool russianRoulette = true;    //If true, paths are ended by Russian roulette rather than after maxDepth bounces. 
+        float timeBudget = 0.0f;        //Seconds to spend refining the image before stopping early, or 0 for no limit. 
+        float noiseThreshold = 0.0f;    //Estimated relative error (see Film::EstimateError) at which to stop early, or 0 to take every sample. 
+        float adaptiveThreshold = 0.0f; //Relative error (see Film::GetPixelError) at which each pixel stops taking samples, or 0 to sample every pixel equally. 
+        ELightSampling lightSampling = ELightSampling::All;
+        uint32_t lightSamples = 1;      //Number of lights chosen at each hit, unless every light is sampled. 
+        bool denoise = false;           //If true, the finished image is denoised, guided by feature buffers gathered from each sample's first hit. 
+        LightSampler lightSampler;      //Chooses lights at each hit, unless every light is sampled. 
+        AreaLights areaLights;          //Emissive geometry, which the path tracer samples as lights. 
+        const AreaLights* pAreaLights = nullptr;    //The area lights to sample; this scene's own, or those of the scene it shares geometry with. 
+        std::unique_ptr<Sampler> pSampler = Sampler::Create(ESampler::Sobol);   //Generates every sample's random numbers. 
         EDX::Acceleration::Grid accelGrid; 
+        uint64_t geometryHash = 0;  //Hash of the commands which define this scene's primitives. Scenes with equal hashes can share acceleration structures. 
+        const RenderData* pSharedGeometry = nullptr;    //An earlier scene with identical geometry, whose primitives, acceleration structure and area lights are used instead of building this scene's own. 
     };
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "Sampler.h"
+#include "Utils/Random.h"
+
+namespace {
+    inline uint32_t ReverseBits(uint32_t x) {
+        x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+        x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+        x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+        x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+        return (x >> 16) | (x << 16);
+    }
+
+    //Each bit is flipped depending only on the bits below it (Laine & Karras 2011, with Vegdahl's constants).
+    inline uint32_t LaineKarrasPermutation(uint32_t x, const uint32_t seed) {
+        x += seed;
+        x ^= x * 0x6c50b47cu;
+        x ^= x * 0xb82f1e52u;
+        x ^= x * 0xc7afe638u;
+        x ^= x * 0x8d22f6e6u;
+        return x;
+    }
+
+    //Owen scrambling of a 32-bit fixed-point value in [0, 1); each bit is flipped depending only on the bits above it.
+    inline uint32_t NestedUniformScramble(const uint32_t x, const uint32_t seed) {
+        return ReverseBits(LaineKarrasPermutation(ReverseBits(x), seed));
+    }
+
+    //The first two dimensions of the Sobol sequence; the van der Corput sequence, and its (0, 2)-sequence partner.
+    inline uint32_t Sobol0(const uint32_t index) {
+        return ReverseBits(index);
+    }
+
+    inline uint32_t Sobol1(uint32_t index) {
+        uint32_t result = 0;
+        for (uint32_t v = 1u << 31; index != 0; index >>= 1, v ^= v >> 1) {
+            if (index & 1u) {
+                result ^= v;
+            }
+        }
+        return result;
+    }
+
+    //Seeds for a pixel's dimension - one to shuffle the sample order, and one to scramble each axis.
+    inline void DimensionSeeds(const uint32_t pixel, const uint32_t dimension, uint32_t seeds[4]) {
+        seeds[0] = pixel;
+        seeds[1] = dimension;
+        seeds[2] = 0x5A3D1E57u;
+        seeds[3] = 0;
+        EDX::PCG4D(seeds);
+    }
+}
+
+std::unique_ptr<EDX::Sampler> EDX::Sampler::Create(const ESampler type)
+{
+    switch (type) {
+    case ESampler::Independent:
+        return std::make_unique<IndependentSampler>();
+    case ESampler::Sobol:
+    default:
+        return std::make_unique<SobolSampler>();
+    }
+}
+
+float EDX::IndependentSampler::Get1D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const
+{
+    uint32_t v[4] = { pixel, sample, dimension, 0 };
+    PCG4D(v);
+    return ToUnitFloat(v[0]);
+}
+
+EDX::Maths::Vector2f EDX::IndependentSampler::Get2D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const
+{
+    uint32_t v[4] = { pixel, sample, dimension, 0 };
+    PCG4D(v);
+    return { ToUnitFloat(v[0]), ToUnitFloat(v[1]) };
+}
+
+float EDX::SobolSampler::Get1D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const
+{
+    uint32_t seeds[4];
+    DimensionSeeds(pixel, dimension, seeds);
+
+    //Shuffling the index with a nested scramble keeps each power-of-two prefix of the samples stratified.
+    const uint32_t index = NestedUniformScramble(sample, seeds[0]);
+    return ToUnitFloat(NestedUniformScramble(Sobol0(index), seeds[1]));
+}
+
+EDX::Maths::Vector2f EDX::SobolSampler::Get2D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const
+{
+    uint32_t seeds[4];
+    DimensionSeeds(pixel, dimension, seeds);
+
+    const uint32_t index = NestedUniformScramble(sample, seeds[0]);
+    return { ToUnitFloat(NestedUniformScramble(Sobol0(index), seeds[1])), ToUnitFloat(NestedUniformScramble(Sobol1(index), seeds[2])) };
+}
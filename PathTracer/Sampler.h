@@ -0,0 +1,63 @@
+#ifndef __SAMPLER_H
+#define __SAMPLER_H
+/**
+ * @file Sampler.h
+ * @brief Per-pixel Sample Generation
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-15
+*/
+#include "Maths/Vector2.h"
+#include <cstdint>
+#include <memory>
+
+namespace EDX {
+    enum class ESampler : uint32_t {
+        Independent = 0,    //Uncorrelated random numbers.
+        Sobol,              //Owen-scrambled Sobol points.
+    };
+
+    /**
+     * @brief Generates the random numbers for each sample of each pixel.
+     * @remark Samplers are stateless; each value depends only on its pixel, sample index and dimension, so images are identical whatever the thread count or block order.
+     * Integrators assign each random decision a fixed dimension (e.g. from its bounce), and consecutive dimensions should be used for unrelated decisions.
+    */
+    class Sampler {
+    public:
+        virtual ~Sampler() = default;
+
+        /**
+         * @brief Returns a value in [0, 1).
+         * @param pixel Index of the pixel within the image.
+         * @param sample Index of the sample within the pixel.
+         * @param dimension Index of the decision within the sample.
+        */
+        virtual float Get1D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const = 0;
+
+        /**
+         * @brief Returns a point in [0, 1)^2, for decisions which should be stratified in two dimensions together (e.g. pixel positions, or directions).
+        */
+        virtual Maths::Vector2f Get2D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const = 0;
+
+        static std::unique_ptr<Sampler> Create(const ESampler type);
+    };
+
+    /**
+     * @brief Hashes the pixel, sample and dimension into uncorrelated random numbers.
+    */
+    class IndependentSampler final : public Sampler {
+    public:
+        float Get1D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const override;
+        Maths::Vector2f Get2D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const override;
+    };
+
+    /**
+     * @brief Generates Owen-scrambled Sobol points, with hash-based scrambling and per-pixel shuffling (Burley 2020).
+     * @remark Each dimension is a separately scrambled 1D or 2D Sobol sequence, so the first 2^k samples of a pixel are well stratified in each decision, and uncorrelated between decisions and pixels.
+    */
+    class SobolSampler final : public Sampler {
+    public:
+        float Get1D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const override;
+        Maths::Vector2f Get2D(const uint32_t pixel, const uint32_t sample, const uint32_t dimension) const override;
+    };
+}
+#endif
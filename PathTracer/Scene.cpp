@@ -1,13 +1,128 @@
 #include "Scene.h"
 #include "Maths/Utils.h"
+#include "Acceleration/RaySort.h"
+#include "Utils/ParallelFor.h"
 #include <vector> 
+#include <atomic>
+
+#if ENABLE_RAY_SORTING
+constexpr bool g_SortRays = true;       //Reorders batches by direction octant and origin before tracing. 
+#else
+constexpr bool g_SortRays = false;
+#endif
+
+constexpr uint64_t g_ParallelTraceThreshold = 16384;    //Batches at least this large are split across threads. 
+constexpr uint64_t g_ParallelTraceChunk = 1024;
 
 EDX::Scene::Scene()
 {
-
+    m_pAccelStructure = nullptr;
 }
 
 bool EDX::Scene::TraceRay(const Ray& r, RayHit& hitResult, Acceleration::Grid& grid) const
+{
+    std::vector<RayHit> results = {}; 
+    results.reserve(32); 
+
+    return Intersect(r, hitResult, grid, results);
+}
+
+bool EDX::Scene::TraceRay(const Ray& r, RayHit& hitResult) const
+{
+    std::vector<RayHit> results = {};
+    results.reserve(32);
+
+    return Intersect(r, hitResult, *m_pAccelStructure, results);
+}
+
+uint64_t EDX::Scene::TraceRays(Span<const Ray> rays, Span<RayHit> hitResults) const
+{
+    const uint64_t count = rays.Size();
+
+    //Optionally reorder the rays, so that rays with similar origins and directions are traced together. 
+    std::vector<uint32_t> order;
+    if (g_SortRays) {
+        Acceleration::SortRays(rays.Data(), count, m_pAccelStructure->GetBoundsMin(), m_pAccelStructure->GetBoundsMax(), order);
+    }
+
+    std::atomic<uint64_t> hits(0);
+    auto trace = [&](uint64_t begin, uint64_t end) {
+        std::vector<RayHit> results = {};
+        results.reserve(32);
+
+        uint64_t localHits = 0;
+        for (uint64_t i = begin; i < end; i++) {
+            const uint64_t idx = g_SortRays ? order[i] : i;
+
+            hitResults[idx] = {};
+            results.clear();
+            if (Intersect(rays[idx], hitResults[idx], *m_pAccelStructure, results)) {
+                localHits++;
+            }
+        }
+        hits += localHits;
+    };
+
+    //Small batches (e.g. a render block's rays) are traced on the calling thread. 
+    if (count >= g_ParallelTraceThreshold) {
+        ParallelFor(count, g_ParallelTraceChunk, trace);
+    }
+    else {
+        trace(0, count);
+    }
+
+    return hits.load();
+}
+
+uint64_t EDX::Scene::OccludedRays(Span<const Ray> rays, Span<const float> maxDistances, Span<uint8_t> occluded) const
+{
+    const uint64_t count = rays.Size();
+
+    std::vector<uint32_t> order;
+    if (g_SortRays) {
+        Acceleration::SortRays(rays.Data(), count, m_pAccelStructure->GetBoundsMin(), m_pAccelStructure->GetBoundsMax(), order);
+    }
+
+    std::atomic<uint64_t> numOccluded(0);
+    auto trace = [&](uint64_t begin, uint64_t end) {
+        uint64_t localOccluded = 0;
+        for (uint64_t i = begin; i < end; i++) {
+            const uint64_t idx = g_SortRays ? order[i] : i;
+
+            //Any hit before the maximum distance blocks the ray, so stop at the first rather than finding the nearest. 
+            bool isOccluded = m_pAccelStructure->Occluded(rays[idx], maxDistances[idx]);
+            for (uint64_t p = 0; p < m_Planes.size() && !isOccluded; p++) {
+                RayHit planeHit = {};
+                isOccluded = m_Planes[p].Intersects(rays[idx], planeHit) && planeHit.t > 0.0f && planeHit.t < maxDistances[idx];
+            }
+
+            occluded[idx] = isOccluded ? 1 : 0;
+            localOccluded += isOccluded ? 1 : 0;
+        }
+        numOccluded += localOccluded;
+    };
+
+    if (count >= g_ParallelTraceThreshold) {
+        ParallelFor(count, g_ParallelTraceChunk, trace);
+    }
+    else {
+        trace(0, count);
+    }
+
+    return numOccluded.load();
+}
+
+void EDX::Scene::SetAccelStructure(const EDX::Acceleration::AccelStructure* pAccelStructure)
+{
+    m_pAccelStructure = pAccelStructure;
+}
+
+const EDX::Acceleration::AccelStructure* EDX::Scene::GetAccelStructure() const
+{
+    return m_pAccelStructure;
+}
+
+bool EDX::Scene::Intersect(const Ray& r, RayHit& hitResult, const Acceleration::AccelStructure& accel, std::vector<RayHit>& results) const
 {
     //Trace the ray through each object in the scene. 
     RayHit result = {};
@@ -15,9 +130,7 @@ bool EDX::Scene::TraceRay(const Ray& r, RayHit& hitResult, Acceleration::Grid& g
     uint32_t intersections = 0;
 
     {
-        std::vector<RayHit> results = {}; 
-        results.reserve(32); 
-        grid.Traverse(r, results); 
+        accel.Traverse(r, results); 
 
         for (const auto& res : results) {
             if (res.t > 0.0f && res.t < nearest) {
@@ -71,6 +184,16 @@ std::vector<EDX::Sphere>& EDX::Scene::Spheres()
     return m_Spheres;
 }
 
+const std::vector<EDX::Triangle>& EDX::Scene::Triangles() const
+{
+    return m_Triangles;
+}
+
+const std::vector<EDX::Sphere>& EDX::Scene::Spheres() const
+{
+    return m_Spheres;
+}
+
 std::vector<EDX::DirectionalLight>& EDX::Scene::DirectionalLights()
 {
     return m_DirectionalLights;
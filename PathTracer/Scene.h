@@ -15,6 +15,7 @@
 #include "RayHit.h"
 #include <vector>
 #include "Acceleration/Grid.h"
+#include "Containers/Span.h"
 
 namespace EDX {
 
@@ -24,14 +25,52 @@ namespace EDX {
 
         bool TraceRay(const Ray& r, RayHit& hitResult, EDX::Acceleration::Grid& grid) const; 
 
+        /**
+         * @brief Traces a single ray through the active acceleration structure.
+         * @return true if the ray hit anything.
+        */
+        bool TraceRay(const Ray& r, RayHit& hitResult) const;
+
+        /**
+         * @brief Finds the nearest hit for each ray in a batch, using the active acceleration structure.
+         * @param rays The rays to trace.
+         * @param hitResults Receives the nearest hit for each ray, at the same index. Rays which miss have t = Infinity and no material.
+         * @return The number of rays which hit something.
+         * @remark Large batches are split across threads, and may be traced out of order.
+        */
+        uint64_t TraceRays(Span<const Ray> rays, Span<RayHit> hitResults) const;
+
+        /**
+         * @brief Tests whether each ray in a batch hits anything before a maximum distance.
+         * @param rays The rays to test.
+         * @param maxDistances The distance along each ray to test up to.
+         * @param occluded Receives 1 for each ray which is blocked, and 0 otherwise.
+         * @return The number of occluded rays.
+         * @remark Each ray stops at the first hit before its maximum distance, so this is cheaper than tracing it to its nearest hit.
+        */
+        uint64_t OccludedRays(Span<const Ray> rays, Span<const float> maxDistances, Span<uint8_t> occluded) const;
+
+        /**
+         * @brief Sets the acceleration structure used by the batched trace functions. Must remain valid while tracing.
+        */
+        void SetAccelStructure(const EDX::Acceleration::AccelStructure* pAccelStructure);
+        const EDX::Acceleration::AccelStructure* GetAccelStructure() const;
+
         std::vector<Plane>& Planes(); 
         std::vector<Triangle>& Triangles(); 
         std::vector<Sphere>& Spheres(); 
+        const std::vector<Triangle>& Triangles() const;
+        const std::vector<Sphere>& Spheres() const;
 
         std::vector<DirectionalLight>& DirectionalLights();
         std::vector<PointLight>& PointLights();
 
     private:
+        bool Intersect(const Ray& r, RayHit& hitResult, const EDX::Acceleration::AccelStructure& accel, std::vector<RayHit>& results) const;
+
+    private:
+        const EDX::Acceleration::AccelStructure* m_pAccelStructure;
+
         std::vector<Plane> m_Planes;
         std::vector<Triangle> m_Triangles;
         std::vector<Sphere> m_Spheres;
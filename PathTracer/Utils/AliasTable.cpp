@@ -0,0 +1,81 @@
+#include "AliasTable.h"
+#include <algorithm>
+
+void EDX::AliasTable::Build(const std::vector<float>& weights)
+{
+    m_Bins.clear();
+
+    double total = 0.0;
+    for (const float w : weights) {
+        total += std::max(w, 0.0f);
+    }
+    if (weights.empty() || total <= 0.0) {
+        return;
+    }
+
+    const uint32_t n = static_cast<uint32_t>(weights.size());
+    m_Bins.resize(n);
+
+    //Scale the weights so they average 1, then split them into bins below and above the average.
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < n; i++) {
+        m_Bins[i].pmf = (float)(std::max(weights[i], 0.0f) / total);
+        scaled[i] = (std::max(weights[i], 0.0f) / total) * n;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    //Fill each under-full bin from an over-full one, which then becomes under-full itself if it's given too much away.
+    while (!small.empty() && !large.empty()) {
+        const uint32_t s = small.back();
+        small.pop_back();
+        const uint32_t l = large.back();
+
+        m_Bins[s].probability = (float)scaled[s];
+        m_Bins[s].alias = l;
+
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    //Whatever's left is full, up to rounding error.
+    for (const uint32_t i : small) {
+        m_Bins[i].probability = 1.0f;
+        m_Bins[i].alias = i;
+    }
+    for (const uint32_t i : large) {
+        m_Bins[i].probability = 1.0f;
+        m_Bins[i].alias = i;
+    }
+}
+
+bool EDX::AliasTable::Sample(const float u, uint32_t& index, float& pmf) const
+{
+    if (m_Bins.empty()) {
+        return false;
+    }
+
+    //The sample picks a bin, and what's left of it chooses between the bin and its alias.
+    const uint32_t n = static_cast<uint32_t>(m_Bins.size());
+    const float scaled = u * (float)n;
+    const uint32_t bin = std::min(static_cast<uint32_t>(scaled), n - 1);
+    const float remainder = scaled - (float)bin;
+
+    index = remainder < m_Bins[bin].probability ? bin : m_Bins[bin].alias;
+    pmf = m_Bins[index].pmf;
+    return pmf > 0.0f;
+}
+
+float EDX::AliasTable::Pmf(const uint32_t index) const
+{
+    return m_Bins[index].pmf;
+}
+
+uint32_t EDX::AliasTable::Size() const
+{
+    return static_cast<uint32_t>(m_Bins.size());
+}
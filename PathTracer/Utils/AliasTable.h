@@ -0,0 +1,48 @@
+#ifndef __ALIASTABLE_H
+#define __ALIASTABLE_H
+/**
+ * @file AliasTable.h
+ * @brief Walker Alias Table, for Sampling Discrete Distributions
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-15
+*/
+#include <cstdint>
+#include <vector>
+
+namespace EDX {
+    /**
+     * @brief Samples an index in proportion to a set of weights in O(1) time, with Walker's alias method (built with Vose's algorithm).
+    */
+    class AliasTable {
+    public:
+        /**
+         * @brief Builds the table. Negative weights are treated as 0.
+        */
+        void Build(const std::vector<float>& weights);
+
+        /**
+         * @brief Chooses an index.
+         * @param u A uniform sample in [0, 1).
+         * @param pmf Receives the probability that the index was chosen.
+         * @return false if the table is empty, or every weight was 0.
+        */
+        bool Sample(const float u, uint32_t& index, float& pmf) const;
+
+        /**
+         * @return The probability that Sample() chooses an index.
+        */
+        float Pmf(const uint32_t index) const;
+
+        uint32_t Size() const;
+
+    private:
+        struct Bin {
+            float probability;      //Probability of keeping this bin's own index, rather than its alias.
+            uint32_t alias;
+            float pmf;              //Probability of choosing this bin's own index overall.
+        };
+
+        std::vector<Bin> m_Bins;
+    };
+}
+#endif
@@ -0,0 +1,27 @@
+#ifndef __HASH_H
+#define __HASH_H
+/**
+ * @file Hash.h
+ * @brief Non-cryptographic Hashing Utilities
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-05
+*/
+#include <cstdint>
+
+namespace EDX {
+    constexpr uint64_t g_FNVOffsetBasis = 0xcbf29ce484222325ull;
+
+    /**
+     * @brief Accumulates a 64-bit FNV-1a hash over a range of bytes.
+    */
+    inline uint64_t HashBytes(const void* pData, const uint64_t size, uint64_t hash = g_FNVOffsetBasis) {
+        const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+        for (uint64_t i = 0; i < size; i++) {
+            hash ^= pBytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef __PARALLELFOR_H
+#define __PARALLELFOR_H
+/**
+ * @file ParallelFor.h
+ * @brief Parallel Loop Utility
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-03
+*/
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+namespace EDX {
+    /**
+     * @brief Splits the range [0, count) into chunks, and invokes fn(begin, end) for each chunk across all hardware threads.
+     * @param count Number of elements in the range.
+     * @param chunkSize Number of elements per chunk. Chunks are claimed dynamically, so smaller chunks balance better.
+     * @param fn Callable with the signature void(uint64_t begin, uint64_t end).
+     * @remark The calling thread also processes chunks, and the function returns once every chunk is complete.
+    */
+    template <typename Fn>
+    void ParallelFor(const uint64_t count, const uint64_t chunkSize, Fn&& fn) {
+        const uint64_t chunk = std::max<uint64_t>(chunkSize, 1);
+        const uint64_t numChunks = (count + chunk - 1) / chunk;
+        const uint32_t numThreads = static_cast<uint32_t>(std::min<uint64_t>(std::max(std::thread::hardware_concurrency(), 1u), numChunks));
+
+        std::atomic<uint64_t> nextChunk(0);
+        auto work = [&]() {
+            for (uint64_t c = nextChunk++; c < numChunks; c = nextChunk++) {
+                const uint64_t begin = c * chunk;
+                const uint64_t end = std::min(begin + chunk, count);
+                fn(begin, end);
+            }
+        };
+
+        //Account for the main thread + (numThreads - 1) workers.
+        std::vector<std::thread> threads;
+        for (uint32_t i = 1; i < numThreads; i++) {
+            threads.emplace_back(work);
+        }
+
+        work();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+}
+#endif
@@ -0,0 +1,44 @@
+#ifndef __RANDOM_H
+#define __RANDOM_H
+/**
+ * @file Random.h
+ * @brief Counter-based Pseudo-random Number Generation
+ * @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+ * @date 2024-10-14
+*/
+#include <cstdint>
+
+namespace EDX {
+    /**
+     * @brief Hashes four 32-bit counters into four uniformly distributed 32-bit values, with the pcg4d hash (Jarzynski & Olano 2020).
+     * @remark Counter-based; the result depends only on the inputs, so random numbers can be drawn for any pixel, sample and dimension without any state.
+    */
+    inline void PCG4D(uint32_t v[4]) {
+        for (int i = 0; i < 4; i++) {
+            v[i] = (v[i] * 1664525u) + 1013904223u;
+        }
+
+        v[0] += v[1] * v[3];
+        v[1] += v[2] * v[0];
+        v[2] += v[0] * v[1];
+        v[3] += v[1] * v[2];
+
+        for (int i = 0; i < 4; i++) {
+            v[i] ^= v[i] >> 16u;
+        }
+
+        v[0] += v[1] * v[3];
+        v[1] += v[2] * v[0];
+        v[2] += v[0] * v[1];
+        v[3] += v[1] * v[2];
+    }
+
+    /**
+     * @brief Maps 32 random bits to a uniform float in [0, 1).
+    */
+    inline float ToUnitFloat(const uint32_t bits) {
+        return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+#endif
@@ -2,11 +2,16 @@
 #include "Utils/Timer.h"
 #include "Utils/ProgressBar.h"
 #include "RayTracer.h"
+#include "Film.h"
+#include "Denoiser.h"
 #include "Containers/TS_Stack.h"
 #include <thread>
 #include <atomic>
 #include <mutex> 
 #include <filesystem>
+#include <fstream>
+#include <memory>
+#include <chrono>
 
 constexpr uint16_t WIDTH = 600;
 constexpr uint16_t HEIGHT = 400;
@@ -21,22 +26,370 @@ constexpr uint32_t MAX_DEPTH = 2;
 
 void ExportImage(const EDX::Image& img, const std::string& outputName, const float gamma = 1.0f);
 
+#if ENABLE_DEBUG_SCENE
+void LoadDebugScene(EDX::RenderData& renderData);
+#endif
+
+/**
+ * @brief A single image to render. Jobs with identical geometry share one acceleration structure.
+ * @remark Images are refined in passes, each of which takes one sample per pixel, until the scene's sample count, time budget or noise threshold is met.
+ * When sampling adaptively, pixels which have converged are skipped, and the image is finished once every pixel has converged. 
+*/
+struct RenderJob {
+    std::string scenePath;
+    std::unique_ptr<EDX::RenderData> pRenderData;
+    std::unique_ptr<EDX::Film> pFilm;
+    std::vector<EDX::Maths::Vector4i> blocks;           //The image's blocks, {xmin, xmax, ymin, ymax}, in the order they're queued for each pass. 
+    std::atomic<uint32_t> blocksRemaining;              //Blocks left to render in the current pass. 
+    std::atomic<uint32_t> pass;                         //Index of the current pass. 
+    std::atomic<int64_t> startTicks;                    //steady_clock ticks when the job's first block began rendering, or 0 if it hasn't yet. Atomic, as the progress bar reads it from every thread. 
+    std::atomic<bool> isFinished;
+};
+
+/**
+ * @brief A block of a job's image - {xmin, xmax, ymin, ymax}
+*/
+struct RenderBlock {
+    uint32_t job;
+    uint32_t pass;
+    EDX::Maths::Vector4i block;
+};
+
 int main(int argc, char* argv[]) {
     EDX::Log::Status("EDX UC San Diego CS-168 Rendering 2 Coursework\nEwan Burnett - 2024\n");
 
-    //Load the scene 
-    EDX::RenderData renderData = {};
-    renderData.accelGrid = EDX::Acceleration::Grid({ 10, 10, 10 });
-
-    std::string scenePath = SCENE_PATH;
-    if (argc > 1) {
-        scenePath = argv[1];
+    //Gather the scenes to render. 
+    //Usage: PathTracer [scene ...] [--batch listFile ...]
+    //       PathTracer --convert scene.test scene.bin
+    //A list file contains one scene path per line. 
+    std::vector<std::string> scenePaths;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--convert" || arg == "-c") {
+            //Convert a text scene to the binary format, then exit without rendering. 
+            if ((i + 2) >= argc) {
+                EDX::Log::Failure("Usage: PathTracer --convert <scene.test> <output>\n");
+                return 1;
+            }
+            return EDX::RayTracer::ConvertSceneFile(argv[i + 1], argv[i + 2]) ? 0 : 1;
+        }
+        else if ((arg == "--batch" || arg == "-b") && (i + 1) < argc) {
+            std::ifstream list(argv[++i]);
+            if (!list.is_open()) {
+                EDX::Log::Failure("Failed to open batch list \"%s\"!\n", argv[i]);
+                continue;
+            }
+            for (std::string line; std::getline(list, line);) {
+                line.erase(line.find_last_not_of(" \t\r") + 1);
+                if (!line.empty() && line[0] != '#') {
+                    scenePaths.push_back(line);
+                }
+            }
+        }
+        else {
+            scenePaths.push_back(arg);
+        }
+    }
+    if (scenePaths.empty()) {
+        scenePaths.push_back(SCENE_PATH);
     }
 
-    if (!EDX::RayTracer::LoadSceneFile(scenePath.c_str(), renderData))
+    //Load each scene. Scenes whose geometry matches an earlier job's reuse its primitives and acceleration structure, rather than building their own. 
+    std::vector<std::unique_ptr<RenderJob>> jobs;
+    std::vector<const EDX::RenderData*> loadedScenes;
+    uint32_t failedJobs = 0;
+
+    for (const auto& scenePath : scenePaths) {
+        auto pJob = std::make_unique<RenderJob>();
+        pJob->scenePath = scenePath;
+        pJob->pRenderData = std::make_unique<EDX::RenderData>();
+
+        EDX::RenderData& renderData = *pJob->pRenderData;
+        renderData.accelGrid = EDX::Acceleration::Grid({ 10, 10, 10 });
+
+        if (!EDX::RayTracer::LoadSceneFile(scenePath.c_str(), renderData, loadedScenes)) {
 #if ENABLE_DEBUG_SCENE
+            //If we can't load a scene, load the debug scene instead.
+            LoadDebugScene(renderData);
+#else
+            EDX::Log::Failure("Failed to load scene \"%s\"!\n", scenePath.c_str());
+            failedJobs++;
+            continue;
+#endif
+        }
+
+        const EDX::RenderData* pShared = renderData.pSharedGeometry;
+        const EDX::Scene& geometry = pShared ? pShared->scene : renderData.scene;
+        EDX::Log::Print("Image Size: (%d x %d)\nMax Depth: %d\nIntegrator: %s\nTriangles: %d\nSpheres: %d\nDirectional Lights: %d\nPoint Lights: %d\n", renderData.dimensions.x, renderData.dimensions.y, renderData.maxDepth, renderData.integrator == EDX::EIntegrator::PathTracer ? "Path Tracer" : "Ray Tracer", geometry.Triangles().size(), geometry.Spheres().size(), renderData.scene.DirectionalLights().size(), renderData.scene.PointLights().size());
+
+        if (pShared) {
+            //Trace against the earlier job's primitives, which this job never built. 
+            EDX::Log::Status("Sharing geometry with \"%s\".\n", pShared->outputName.c_str());
+            renderData.scene.SetAccelStructure(pShared->scene.GetAccelStructure());
+        }
+        else {
+            renderData.accelGrid.Build(renderData);
+            renderData.scene.SetAccelStructure(&renderData.accelGrid);
+        }
+
+        loadedScenes.push_back(&renderData);
+        jobs.push_back(std::move(pJob));
+    }
+
+    //Split each image into Blocks to process. 
+    //Every job's blocks share one queue, so threads move straight on to the next job rather than idling while a job's last blocks finish. 
+    const EDX::Maths::Vector2i blockDim = { 64u, 64u };
+
+    EDX::TS_Stack<RenderBlock> imageBlocks;
+    std::atomic<uint32_t> jobsRemaining(0);
+
+    auto queuePass = [&](const uint32_t j, const uint32_t pass) {
+        RenderJob& job = *jobs[j];
+        job.pass = pass;
+        job.blocksRemaining = static_cast<uint32_t>(job.blocks.size());
+        for (const auto& b : job.blocks) {
+            RenderBlock block = { j, pass, b };
+            imageBlocks.Wait_And_Push(block);
+        }
+    };
+
+    //The queue is LIFO, so push the last job first. 
+    for (int64_t j = (int64_t)jobs.size() - 1; j >= 0; j--) {
+        RenderJob& job = *jobs[j];
+        const EDX::RenderData& renderData = *job.pRenderData;
+
+        job.pFilm = std::make_unique<EDX::Film>(renderData.dimensions.x, renderData.dimensions.y);
+
+        const uint32_t blocks_y = (renderData.dimensions.y / blockDim.y);
+        const uint32_t blocks_x = (renderData.dimensions.x / blockDim.x);
+
+        for (int64_t y = blocks_y; y >= 0; y--) {
+            for (int64_t x = blocks_x; x >= 0; x--) {
+                //Compute each block size
+                const int x_min = EDX::Maths::Clamp((int)blockDim.x * (int)x, 0, (int)renderData.dimensions.x);
+                const int x_max = EDX::Maths::Clamp(x_min + blockDim.x, 0, (int)renderData.dimensions.x);
+                if (x_min == x_max) {
+                    continue;
+                }
+
+                const int y_min = EDX::Maths::Clamp((int)blockDim.y * (int)y, 0, (int)renderData.dimensions.y);
+                const int y_max = EDX::Maths::Clamp(y_min + blockDim.y, 0, (int)renderData.dimensions.y);
+
+                if (y_min == y_max) {
+                    continue;
+                }
+
+                job.blocks.push_back({  //TODO: convert Vec4i to Vec4<uint32_t>
+                    x_min, x_max,   //xmin, xmax
+                    y_min, y_max    //ymin, ymax
+                });
+            }
+        }
+
+        job.startTicks = 0;
+        job.isFinished = job.blocks.empty();
+        if (!job.isFinished) {
+            jobsRemaining++;
+            queuePass(static_cast<uint32_t>(j), 0);
+        }
+    }
+
+    EDX::Log::Print("Jobs: %d\nNum Blocks: %d\nBlock Dimensions: %d x %d\n", jobs.size(), imageBlocks.Size(), blockDim.x, blockDim.y);
+
+    EDX::Log::Status("Rendering %d Image(s)\n", jobs.size());
+    EDX::ProgressBar pb;
+
+    //Render the Images
+    std::atomic<uint64_t> samplesTaken(0);
+
+    auto elapsedSeconds = [](const RenderJob& job) {
+        const std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::duration(job.startTicks.load()));
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    };
+
+    //Estimates how far through a job is, from whichever of its sample count or time budget will end it first. 
+    auto jobProgress = [&](const RenderJob& job) {
+        if (job.isFinished) {
+            return 1.0;
+        }
+        if (job.startTicks == 0) {
+            return 0.0;
+        }
+
+        const EDX::RenderData& renderData = *job.pRenderData;
+        const double passProgress = 1.0 - ((double)job.blocksRemaining / (double)job.blocks.size());
+        double progress = ((double)job.pass + passProgress) / (double)renderData.samplesPerPixel;
+        if (renderData.timeBudget > 0.0f) {
+            progress = std::max(progress, elapsedSeconds(job) / (double)renderData.timeBudget);
+        }
+        return std::min(progress, 1.0);
+    };
+
+    //Called by whichever thread finishes a pass's last block. Either queues the next pass, or exports the image and releases it. 
+    auto finishPass = [&](const uint32_t j, const uint32_t pass) {
+        RenderJob& job = *jobs[j];
+        const EDX::RenderData& renderData = *job.pRenderData;
+        const uint32_t samples = pass + 1;
+
+        bool isComplete = samples >= renderData.samplesPerPixel;
+        if (!isComplete && renderData.timeBudget > 0.0f) {
+            isComplete = elapsedSeconds(job) >= (double)renderData.timeBudget;
+        }
+        if (!isComplete && renderData.adaptiveThreshold > 0.0f) {
+            isComplete = job.pFilm->UpdateConvergence(renderData.adaptiveThreshold) == 0;
+        }
+        if (!isComplete && renderData.noiseThreshold > 0.0f) {
+            isComplete = job.pFilm->EstimateError() <= renderData.noiseThreshold;
+        }
+
+        if (!isComplete) {
+            queuePass(j, pass + 1);
+            return;
+        }
+
+        EDX::Log::Status("Finished %s after %u pass(es), in %.2fs.\n", renderData.outputName.empty() ? "Render" : renderData.outputName.c_str(), samples, elapsedSeconds(job));
+
+        EDX::Image image(renderData.dimensions.x, renderData.dimensions.y);
+        const std::string baseName = std::filesystem::path(renderData.outputName).replace_extension().string();
+
+        if (renderData.denoise) {
+            //The noisy image and the feature buffers which guided the denoiser are exported alongside it. 
+            job.pFilm->Resolve(image);
+            ExportImage(image, baseName + "_noisy");
+            job.pFilm->ResolveAlbedo(image);
+            ExportImage(image, baseName + "_albedo");
+            job.pFilm->ResolveNormals(image);
+            ExportImage(image, baseName + "_normal");
+            job.pFilm->ResolveDepth(image);
+            ExportImage(image, baseName + "_depth");
+
+            const auto denoiseStart = std::chrono::steady_clock::now();
+            EDX::Denoiser::Denoise(*job.pFilm, image);
+            EDX::Log::Status("Denoised %s in %.3fs.\n", renderData.outputName.empty() ? "Render" : renderData.outputName.c_str(), std::chrono::duration<double>(std::chrono::steady_clock::now() - denoiseStart).count());
+        }
+        else {
+            job.pFilm->Resolve(image);
+        }
+        ExportImage(image, renderData.outputName);
+
+        //Adaptive renders are also exported as a heatmap of where their samples went. 
+        if (renderData.adaptiveThreshold > 0.0f) {
+            job.pFilm->ResolveSampleCounts(image);
+            ExportImage(image, baseName + "_samples");
+        }
+
+        job.pFilm.reset();
+        job.isFinished = true;
+        if (--jobsRemaining == 0) {
+            imageBlocks.Close();
+        }
+    };
+
+    auto render = [&](const RenderBlock& block)
+    {
+        RenderJob& job = *jobs[block.job];
+        const EDX::Maths::Vector4i& b = block.block;
+        const EDX::RenderData& renderData = *job.pRenderData;
+
+        //Only the first block sets the start time. It's published in one store, so other threads never see a job as started without it. 
+        if (job.startTicks == 0) {
+            int64_t notStarted = 0;
+            job.startTicks.compare_exchange_strong(notStarted, std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+
+        //Once every pixel has a sample, the rest of the pass's blocks are skipped when the time budget runs out. 
+        //The film averages each pixel over the samples it did take, so a partial pass doesn't bias the image. 
+        const bool isOutOfTime = block.pass > 0 && renderData.timeBudget > 0.0f && elapsedSeconds(job) >= (double)renderData.timeBudget;
+        if (!isOutOfTime) {
+            samplesTaken += EDX::RayTracer::RenderBlock(b, block.pass, *job.pRenderData, *job.pFilm);
+        }
+
+        //Only update the progress bar once per block, as it's SLOW. 
+        double p = 0.0;
+        for (const auto& j : jobs) {
+            p += jobProgress(*j);
+        }
+        pb.Update((float)(p / (double)jobs.size()));
+
+        if (--job.blocksRemaining == 0) {
+            finishPass(block.job, block.pass);
+        }
+    };
+
+    auto worker = [&]() {
+        //Sleep while the queue is empty; e.g. while another thread finishes a pass, and may queue the next. 
+        //The queue is closed once every job has finished. 
+        RenderBlock block = {};
+        while (imageBlocks.Wait_For_Pop(block)) {
+            //Process a block of the image. 
+            render(block);
+        }
+    };
+
+    if (jobsRemaining == 0) {
+        imageBlocks.Close();
+    }
+
+    //Kick off worker threads, each rendering sections of the images. 
+    const uint32_t num_threads = std::max(NUM_THREADS, 1u);
+    std::vector<std::thread> threads(num_threads - 1);  //Account for the main thread + (NUM_THREADS - 1) workers.
+
+    EDX::Log::Print("Processing on %d Threads.\n", num_threads);
+
+    for (int i = 1; i < num_threads; i++) {
+        threads[i - 1] = std::thread(worker);
+    }
+
+    //Have the main thread render too. 
+    worker();
+
+    //Wait for the worker threads to complete.
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    //Report how long it took to render to the console. 
+    const double render_time_s = pb.GetProgressTimer().Duration();
+    EDX::Log::Success("\nRender Complete in %.8fs.\nTook %llu samples across %d image(s)\n", render_time_s, (unsigned long long)samplesTaken.load(), jobs.size());
+
+    return failedJobs > 0 ? 1 : 0;
+}
+
+
+
+void ExportImage(const EDX::Image& img, const std::string& outputName, const float gamma)
+{
+    EDX::Log::Status("Exporting %s to PNG...\n", outputName.empty() ? "Render" : outputName.c_str());
+    std::filesystem::create_directory(OUTPUT_DIRECTORY);
+
+    //Format the filename in relation to the output path. 
+    char buffer[0xff];
+    strcpy(buffer, OUTPUT_DIRECTORY);
+    strcat(buffer, "/");
+    if (!outputName.empty()) {
+        strcat(buffer, outputName.c_str());
+        strcat(buffer, "_");
+    }
+
+    //Format a timestamp for this render
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    std::time_t time = std::chrono::system_clock::to_time_t(now);
+    std::tm tm = *std::localtime(&time);
+
+    size_t len = strlen(buffer);
+    strftime(buffer + len, 0xff - len, "%Y-%m-%d_%H-%M-%S.png", &tm);
 
-    {   //If we can't load a scene, load the debug scene instead.
+    EDX::Log::Status("Output Path: %s/%s\n", std::filesystem::current_path().generic_string().c_str(), buffer);
+    img.ExportToPNG(buffer, gamma);
+
+    EDX::Log::Status("Export Complete.\n");
+}
+
+
+#if ENABLE_DEBUG_SCENE
+void LoadDebugScene(EDX::RenderData& renderData)
+{
+    {
         //Context
         {
             renderData.outputName = OUTPUT_NAME;
@@ -62,6 +415,7 @@ int main(int argc, char* argv[]) {
             EDX::Maths::Vector3f lookAt = { 0.0f, 0.0f, 0.0f };
             EDX::Maths::Vector3f up = { 0.0f, 1.0f, 0.0f };
             renderData.camera = EDX::Camera(lookFrom, lookAt, up, EDX::Maths::DegToRad(95.0));
+            renderData.camera.SetViewport({ 0, renderData.dimensions.x, 0, renderData.dimensions.y });
         }
         //Scene
         {
@@ -301,153 +655,8 @@ int main(int argc, char* argv[]) {
       }
   }
       */
-#else 
-    {
-        EDX::Log::Failure("Failed to load scene!\n");
-        return 1;
-    }
-#endif
-
-    EDX::Log::Print("Image Size: (%d x %d)\nMax Depth: %d\nTriangles: %d\nSpheres: %d\nDirectional Lights: %d\nPoint Lights: %d\n", renderData.dimensions.x, renderData.dimensions.y, renderData.maxDepth, renderData.scene.Triangles().size(), renderData.scene.Spheres().size(), renderData.scene.DirectionalLights().size(), renderData.scene.PointLights().size());
-    renderData.accelGrid.Build(renderData);
 
-
-    EDX::Log::Status("Rendering Image \"%s\" \n", renderData.outputName.c_str());
-    EDX::ProgressBar pb;
-
-    EDX::Image img(renderData.dimensions.x, renderData.dimensions.y);
-
-    //Render the Image
-    std::atomic<uint32_t> pixelsProcessed(0);
-    uint32_t totalPixels = img.Size();
-
-    auto render = [&](EDX::Maths::Vector2<int> dim_x, EDX::Maths::Vector2<int> dim_y)
-    {
-        for (uint32_t y = dim_y.x; y < dim_y.y; y++) {
-            for (uint32_t x = dim_x.x; x < dim_x.y; x++) {
-
-                const EDX::Colour pixelColour = EDX::RayTracer::RenderPixel(x, y, renderData);
-
-                img.SetPixel(x, y, pixelColour);
-                pixelsProcessed++;
-            }
-
-            //Only update the progress bar in the outer part of the loop, as it's SLOW. 
-            const float p = (float)(pixelsProcessed) / (float)(totalPixels);
-            pb.Update(p);
-        }
-    };
-
-
-    //Split the image into Blocks to process. 
-    const EDX::Maths::Vector2i blockDim = { 64u, 64u };
-
-    EDX::TS_Stack<EDX::Maths::Vector4i> imageBlocks;
-
-    const uint32_t blocks_y = (renderData.dimensions.y / blockDim.y);
-    const uint32_t remainder_x = renderData.dimensions.x % blockDim.x;
-
-    const uint32_t blocks_x = (renderData.dimensions.x / blockDim.x);
-    const uint32_t remainder_y = renderData.dimensions.y % blockDim.y;
-
-    for (uint32_t y = 0; y < blocks_y + 1; y++) {
-        for (uint32_t x = 0; x < blocks_x + 1; x++) {
-            //Compute each block size
-            const int x_min = EDX::Maths::Clamp((int)blockDim.x * (int)x, 0, (int)renderData.dimensions.x);
-            const int x_max = EDX::Maths::Clamp(x_min + blockDim.x, 0, (int)renderData.dimensions.x);
-            if (x_min == x_max) {
-                continue;
-            }
-
-            const int y_min = EDX::Maths::Clamp((int)blockDim.y * (int)y, 0, (int)renderData.dimensions.y);
-            const int y_max = EDX::Maths::Clamp(y_min + blockDim.y, 0, (int)renderData.dimensions.y);
-
-            if (y_min == y_max) {
-                continue;
-            }
-            EDX::Maths::Vector4i block = {  //TODO: convert Vec4i to Vec4<uint32_t>
-                x_min, x_max,   //xmin, xmax
-                y_min, y_max    //ymin, ymax
-            };
-
-
-            imageBlocks.Wait_And_Push(block);
-        }
-    }
-
-    EDX::Log::Print("Num Blocks: %d\nBlock Dimensions: %d x %d\n", imageBlocks.Size(), blockDim.x, blockDim.y);
-
-    //Kick off worker threads, each rendering sections of the image. 
-    const uint32_t num_threads = NUM_THREADS;
-    std::vector<std::thread> threads(num_threads - 1);  //Account for the main thread + (NUM_THREADS - 1) workers.
-
-    EDX::Log::Print("Processing on %d Threads.\n", num_threads);
-
-    for (int i = 1; i < num_threads; i++) {
-        threads[i - 1] = std::thread([&](int idx) {
-            while (imageBlocks.Empty() == false) {
-                //Process a block of the image. 
-                const EDX::Maths::Vector4i block = imageBlocks.Wait_And_Pop();
-                render({ block.x, block.y }, { block.z, block.w });
-            }
-
-            }, i);
-    }
-
-    //Have the main thread render too. 
-    while (imageBlocks.Empty() == false) {
-        //Process a block of the image. 
-        const EDX::Maths::Vector4i block = imageBlocks.Wait_And_Pop();
-        render({ block.x, block.y }, { block.z, block.w });
-    }
-
-
-    //Wait for the worker threads to complete.
-    uint32_t completeThreads = 0;
-    while (completeThreads < (num_threads - 1)) {
-        for (auto& t : threads) {
-            if (t.joinable()) {
-                t.join();
-                completeThreads++;
-            }
-        }
-    }
-
-    //Report how long it took to render to the console. 
-    const double render_time_s = pb.GetProgressTimer().Duration();
-    EDX::Log::Success("\nRender Complete in %.8fs.\nProcessed %d / %d pixels\n", render_time_s, pixelsProcessed.load(), img.Size());
-
-    ExportImage(img, renderData.outputName);
-
-    return 0;
-}
-
-
-
-void ExportImage(const EDX::Image& img, const std::string& outputName, const float gamma)
-{
-    EDX::Log::Status("Exporting %s to PNG...\n", outputName.empty() ? "Render" : outputName.c_str());
-    std::filesystem::create_directory(OUTPUT_DIRECTORY);
-
-    //Format the filename in relation to the output path. 
-    char buffer[0xff];
-    strcpy(buffer, OUTPUT_DIRECTORY);
-    strcat(buffer, "/");
-    if (!outputName.empty()) {
-        strcat(buffer, outputName.c_str());
-        strcat(buffer, "_");
-    }
-
-    //Format a timestamp for this render
-    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-    std::time_t time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&time);
-
-    size_t len = strlen(buffer);
-    strftime(buffer + len, 0xff - len, "%Y-%m-%d_%H-%M-%S.png", &tm);
-
-    EDX::Log::Status("Output Path: %s/%s\n", std::filesystem::current_path().generic_string().c_str(), buffer);
-    img.ExportToPNG(buffer, gamma);
-
-    EDX::Log::Status("Export Complete.\n");
+    //The debug scene has no emissive geometry, but the path tracer still expects a set of area lights. 
+    renderData.pAreaLights = &renderData.areaLights;
 }
+#endif
@@ -1,10 +1,9 @@
-../PathTracer.exe Scenes/HW1/scene4-ambient.test 
-../PathTracer.exe Scenes/HW1/scene4-emission.test 
-../PathTracer.exe Scenes/HW1/scene4-diffuse.test 
-../PathTracer.exe Scenes/HW1/scene4-specular.test 
-
-../PathTracer.exe Scenes/HW1/scene5.test 
-
-../PathTracer.exe Scenes/HW1/scene6.test 
-
-../PathTracer.exe Scenes/HW1/scene7.test 
\ No newline at end of file
+# Render every scene in a single process, so the worker threads stay busy between scenes.
+../PathTracer.exe \
+    Scenes/HW1/scene4-ambient.test \
+    Scenes/HW1/scene4-emission.test \
+    Scenes/HW1/scene4-diffuse.test \
+    Scenes/HW1/scene4-specular.test \
+    Scenes/HW1/scene5.test \
+    Scenes/HW1/scene6.test \
+    Scenes/HW1/scene7.test
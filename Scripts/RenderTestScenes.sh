@@ -1,10 +1,10 @@
-../PathTracer.exe Scenes/TestScenes/scene1-camera1.test 
-../PathTracer.exe Scenes/TestScenes/scene1-camera2.test 
-../PathTracer.exe Scenes/TestScenes/scene1-camera3.test 
-../PathTracer.exe Scenes/TestScenes/scene1-camera4.test 
-
-../PathTracer.exe Scenes/TestScenes/scene2-camera1.test
-../PathTracer.exe Scenes/TestScenes/scene2-camera2.test
-./PathTracer.exe Scenes/TestScenes/scene2-camera3.test
-
-../PathTracer.exe Scenes/TestScenes/scene3.test 
\ No newline at end of file
+# Render every scene in a single process. Camera variants of the same scene share their geometry and acceleration structure.
+../PathTracer.exe \
+    Scenes/TestScenes/scene1-camera1.test \
+    Scenes/TestScenes/scene1-camera2.test \
+    Scenes/TestScenes/scene1-camera3.test \
+    Scenes/TestScenes/scene1-camera4.test \
+    Scenes/TestScenes/scene2-camera1.test \
+    Scenes/TestScenes/scene2-camera2.test \
+    Scenes/TestScenes/scene2-camera3.test \
+    Scenes/TestScenes/scene3.test